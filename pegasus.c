@@ -25,12 +25,12 @@
 #include <string.h>
 #include <sysexits.h>
 
-#include "pegasus_block.h"
 #include "pegasus_channel.h"
 #include "pegasus_error.h"
 #include "pegasus_fec.h"
 #include "pegasus_modulation.h"
 #include "pegasus_panic.h"
+#include "pegasus_pipeline.h"
 #include "pegasus_random.h"
 #include "pegasus_selftests.h"
 #include "pegasus_source.h"
@@ -45,36 +45,28 @@ int main(int argc, char** argv)
 		pgs_modulation = PGM_ASK,
 		pgs_channel = PGC_AWGN,
 		pgs_error = PGE_BER,
+		pgs_precision = PGL_DOUBLE,
 		pgs_units = PGU_DBS,
 		pgs_quiet = 0,
-		pgs_selftest = 0;
+		pgs_selftest = 0,
+		pgs_common_noise = 0,
+		pgs_seeded = 0;
 	unsigned long long
 		pgs_iterations = 200000,
-		pgs_data_sequence_length = 0,
-		pgs_data_source_blocks_count = 0,
-		pgs_data_encoded_blocks_count = 0,
-		pgs_data_premodulated_blocks_count = 0,
-		pgs_data_modulated_signals_count = 0,
-		pgs_data_noised_signals_count = 0,
-		pgs_data_demodulated_blocks_count = 0,
-		pgs_data_predecoded_blocks_count = 0,
-		pgs_data_decoded_blocks_count = 0,
-		pgs_data_target_blocks_count = 0;
+		pgs_target_errors = 0,
+		pgs_points_count = 0,
+		pgs_seed = 0;
 	double
 		pgs_hsquare_start = 0,
 		pgs_hsquare_end = 15,
-		pgs_hsquare_step = 0.5;
+		pgs_hsquare_step = 0.5,
+		pgs_confidence = 0;
 
-	pgs_block_t* pgs_data_source = NULL;
-	pgs_block_t* pgs_data_source_blocks = NULL;
-	pgs_block_t* pgs_data_encoded_blocks = NULL;
-	pgs_block_t* pgs_data_premodulated_blocks = NULL;
-	pgs_signal_t* pgs_data_modulated_signals = NULL;
-	pgs_signal_t* pgs_data_noised_signals = NULL;
-	pgs_block_t* pgs_data_demodulated_blocks = NULL;
-	pgs_block_t* pgs_data_predecoded_blocks = NULL;
-	pgs_block_t* pgs_data_decoded_blocks = NULL;
-	pgs_block_t* pgs_data_target_blocks = NULL;
+	double* pgs_hsquares = NULL;
+	double* pgs_hsquares_times = NULL;
+
+	pgs_pipeline_t pgs_pipeline;
+	pgs_errors_t* pgs_errors = NULL;
 
 	int opts;
 
@@ -85,17 +77,22 @@ int main(int argc, char** argv)
 		{"modulation",		required_argument,	NULL, 'm'},
 		{"channel",		required_argument,	NULL, 'c'},
 		{"error",		required_argument,	NULL, 'e'},
+		{"precision",		required_argument,	NULL, 'p'},
 		{"hsquare-start",	required_argument,	NULL, 'h'},
 		{"hsquare-end",		required_argument,	NULL, 'n'},
 		{"hsquare-step",	required_argument,	NULL, 't'},
 		{"units",		required_argument,	NULL, 'u'},
 		{"iterations",		required_argument,	NULL, 'i'},
+		{"common-noise",	no_argument,		NULL, 'r'},
+		{"target-errors",	required_argument,	NULL, 'g'},
+		{"confidence",		required_argument,	NULL, 'w'},
+		{"seed",		required_argument,	NULL, 'd'},
 		{"quiet",		no_argument,		NULL, 'q'},
 		{"self-test",		no_argument,		NULL, 'l'},
 		{0, 0, 0, 0}
 	};
 
-	while ((opts = getopt_long(argc, argv, "sfmcehntuiql", longopts, NULL)) != -1)
+	while ((opts = getopt_long(argc, argv, "sfmcephntuirgwdql", longopts, NULL)) != -1)
 		switch (opts)
 		{
 			case 's':
@@ -117,6 +114,12 @@ int main(int argc, char** argv)
 					pgs_fec = PGF_BCH1557;
 				else if (strcmp(optarg, "bch1575") == 0)
 					pgs_fec = PGF_BCH1575;
+				else if (strcmp(optarg, "bch63457") == 0)
+					pgs_fec = PGF_BCH63457;
+				else if (strcmp(optarg, "bch2552239") == 0)
+					pgs_fec = PGF_BCH2552239;
+				else if (strcmp(optarg, "bch102392321") == 0)
+					pgs_fec = PGF_BCH102392321;
 				else
 					pgp_usage(opts, optarg);
 				break;
@@ -175,6 +178,14 @@ int main(int argc, char** argv)
 				else
 					pgp_usage(opts, optarg);
 				break;
+			case 'p':
+				if (strcmp(optarg, "double") == 0)
+					pgs_precision = PGL_DOUBLE;
+				else if (strcmp(optarg, "single") == 0)
+					pgs_precision = PGL_SINGLE;
+				else
+					pgp_usage(opts, optarg);
+				break;
 			case 'h':
 				pgs_hsquare_start = atof(optarg);
 				break;
@@ -193,7 +204,20 @@ int main(int argc, char** argv)
 					pgp_usage(opts, optarg);
 				break;
 			case 'i':
-				pgs_iterations = atoi(optarg);
+				pgs_iterations = strtoull(optarg, NULL, 10);
+				break;
+			case 'r':
+				pgs_common_noise = 1;
+				break;
+			case 'g':
+				pgs_target_errors = strtoull(optarg, NULL, 10);
+				break;
+			case 'w':
+				pgs_confidence = atof(optarg);
+				break;
+			case 'd':
+				pgs_seed = strtoull(optarg, NULL, 0);
+				pgs_seeded = 1;
 				break;
 			case 'q':
 				pgs_quiet = 1;
@@ -206,8 +230,11 @@ int main(int argc, char** argv)
 				exit(EX_USAGE);
 		}
 
+	if (pgs_seeded == 0)
+		pgs_seed = pgr_time_seed();
+
 	pgt_init_threads();
-	pgr_init_seed();
+	pgr_init_seed(pgs_seed);
 	pgf_init_polynomes();
 	pgf_init_syndromes();
 	pgm_init_tables();
@@ -215,8 +242,10 @@ int main(int argc, char** argv)
 	if (pgs_selftest == 1)
 	{
 		pgst_run_tests();
+		pgm_done_tables();
 		pgf_done_syndromes();
 		pgf_done_polynomes();
+		pgt_done_threads();
 		exit(EX_OK);
 	}
 
@@ -227,182 +256,78 @@ int main(int argc, char** argv)
 		printf("Modulation: %s\n", pgm_to_string(pgs_modulation));
 		printf("Channel: %s\n", pgc_channel_to_string(pgs_channel));
 		printf("Error type: %s\n", pge_to_string(pgs_error));
+		printf("Precision: %s\n", pgl_precision_to_string(pgs_precision));
 		printf("h²=[%lf, %lf] %s, with %lf step\n",
 				pgs_hsquare_start,
 				pgs_hsquare_end,
 				pgu_units_to_string(pgs_units),
 				pgs_hsquare_step);
-		printf("Iterations: %llu\n", pgs_iterations);
+		if (pgs_target_errors > 0 || pgs_confidence > 0)
+			printf("Iterations: up to %llu, until %llu errors or %lf relative confidence interval\n",
+					pgs_iterations,
+					pgs_target_errors,
+					pgs_confidence);
+		else
+			printf("Iterations: %llu\n", pgs_iterations);
+		if (pgs_common_noise == 1)
+			printf("Noise: common random numbers across h² points\n");
+		printf("Seed: %llu\n", pgs_seed);
 	}
 
+	for (double hsquare = pgs_hsquare_start; hsquare <= pgs_hsquare_end; hsquare += pgs_hsquare_step)
+		pgs_points_count++;
+	pgs_hsquares = pgt_alloc(pgs_points_count, sizeof(double));
+	pgs_hsquares_times = pgt_alloc(pgs_points_count, sizeof(double));
+	pgs_errors = pgt_alloc(pgs_points_count, sizeof(pgs_errors_t));
+	pgs_points_count = 0;
 	for (double hsquare = pgs_hsquare_start; hsquare <= pgs_hsquare_end; hsquare += pgs_hsquare_step)
 	{
-		pgs_data_sequence_length =
-			pgs_generate(&pgs_data_source,
-				pgs_source,
-				pgs_modulation,
-				pgs_iterations);
-		if (unlikely(pgs_data_sequence_length == 0))
-			pgp_nodata();
-
-		pgs_data_source_blocks_count =
-			pgt_blocks_to_blocks(&pgs_data_source_blocks,
-					pgs_data_source,
-					1,
-					pgf_get_input_block_size(pgs_fec));
-		if (unlikely(pgs_data_source_blocks_count == 0))
-			pgp_nodata();
-
-		pgs_data_encoded_blocks_count =
-			pgf_encode_blocks(&pgs_data_encoded_blocks,
-					pgs_data_source_blocks,
-					pgs_data_source_blocks_count,
-					pgs_fec);
-		if (unlikely(pgs_data_encoded_blocks_count == 0))
-			pgp_nodata();
-
-		pgs_data_premodulated_blocks_count =
-			pgt_blocks_to_blocks(&pgs_data_premodulated_blocks,
-					pgs_data_encoded_blocks,
-					pgs_data_encoded_blocks_count,
-					pgm_get_block_size(pgs_modulation));
-		if (unlikely(pgs_data_premodulated_blocks_count == 0))
-			pgp_nodata();
+		pgs_hsquares[pgs_points_count] = hsquare;
+		pgs_hsquares_times[pgs_points_count] = pgs_units == PGU_TIMES ? hsquare : pgt_dbs_to_times(hsquare);
+		pgs_points_count++;
+	}
 
-		pgs_data_modulated_signals_count =
-			pgm_modulate(&pgs_data_modulated_signals,
-					pgs_data_premodulated_blocks,
-					pgs_data_premodulated_blocks_count,
-					pgs_modulation);
-		if (unlikely(pgs_data_modulated_signals_count == 0))
-			pgp_nodata();
+	pgs_pipeline.source = pgs_source;
+	pgs_pipeline.fec = pgs_fec;
+	pgs_pipeline.modulation = pgs_modulation;
+	pgs_pipeline.channel = pgs_channel;
+	pgs_pipeline.error = pgs_error;
+	pgs_pipeline.precision = pgs_precision;
+	pgs_pipeline.common_noise = pgs_common_noise;
+	pgs_pipeline.target_errors = pgs_target_errors;
+	pgs_pipeline.confidence = pgs_confidence;
+	pgl_init(&pgs_pipeline);
 
-		pgs_data_noised_signals_count =
-			pgc_add_noise(&pgs_data_noised_signals,
-					pgs_data_modulated_signals,
-					pgs_data_modulated_signals_count,
-					pgs_channel,
-					pgs_units == PGU_TIMES ? hsquare : pgt_dbs_to_times(hsquare));
-		if (unlikely(pgs_data_noised_signals_count == 0))
-			pgp_nodata();
+	pgl_run(&pgs_pipeline,
+			pgs_errors,
+			pgs_hsquares_times,
+			pgs_points_count,
+			pgs_iterations);
 
-		pgs_data_demodulated_blocks_count =
-			pgm_demodulate(&pgs_data_demodulated_blocks,
-					pgs_data_noised_signals,
-					pgs_data_noised_signals_count,
-					pgs_modulation);
-		if (unlikely(pgs_data_demodulated_blocks_count == 0))
+	for (unsigned long long i = 0; i < pgs_points_count; i++)
+	{
+		if (unlikely(pgs_errors[i].bits == 0))
 			pgp_nodata();
 
-		pgs_data_predecoded_blocks_count =
-			pgt_blocks_to_blocks(&pgs_data_predecoded_blocks,
-					pgs_data_demodulated_blocks,
-					pgs_data_demodulated_blocks_count,
-					pgs_fec == PGF_NONE ? pgs_data_sequence_length : pgf_get_output_block_size(pgs_fec));
-		if (unlikely(pgs_data_predecoded_blocks_count == 0))
-			pgp_nodata();
+		unsigned long long wrong = pgs_error == PGE_SER ? pgs_errors[i].wrong_symbols : pgs_errors[i].wrong_bits;
+		unsigned long long total = pgs_error == PGE_SER ? pgs_errors[i].symbols : pgs_errors[i].bits;
 
-		pgs_data_decoded_blocks_count =
-			pgf_decode_blocks(&pgs_data_decoded_blocks,
-					pgs_data_predecoded_blocks,
-					pgs_data_predecoded_blocks_count,
-					pgs_fec);
-		if (unlikely(pgs_data_decoded_blocks_count == 0))
-			pgp_nodata();
+		if (pgs_target_errors > 0 || pgs_confidence > 0)
+			printf("%lf\t\t%1.16lf\t%llu\t%llu\n", pgs_hsquares[i], (double)wrong / (double)total, wrong, total);
+		else
+			printf("%lf\t\t%1.16lf\n", pgs_hsquares[i], (double)wrong / (double)total);
+	}
 
-		pgs_data_target_blocks_count =
-			pgt_blocks_to_blocks(&pgs_data_target_blocks,
-				pgs_data_decoded_blocks,
-				pgs_data_decoded_blocks_count,
-				pgs_data_sequence_length);
-		if (unlikely(pgs_data_target_blocks_count == 0))
-			pgp_nodata();
+	pgl_done(&pgs_pipeline);
 
-		if (pgs_error == PGE_BER)
-			printf("%lf\t\t%1.16lf\n", hsquare, pgt_get_ber(pgs_data_source,
-						pgs_data_target_blocks,
-						pgs_data_sequence_length));
-		else if (pgs_error == PGE_SER)
-		{
-			if (pgs_fec == PGF_NONE)
-				printf("%lf\t\t%1.16lf\n", hsquare, pgt_get_ser(pgs_data_premodulated_blocks,
-							pgs_data_demodulated_blocks,
-							pgs_data_premodulated_blocks_count));
-			else
-				printf("%lf\t\t%1.16lf\n", hsquare, pgt_get_ser(pgs_data_source_blocks,
-							pgs_data_decoded_blocks,
-							pgs_data_source_blocks_count));
-		}
-
-#if defined (_OPENMP)
-#pragma omp parallel sections
-#endif
-	{
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_target_blocks, pgs_data_target_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_decoded_blocks, pgs_data_decoded_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_predecoded_blocks, pgs_data_predecoded_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_demodulated_blocks, pgs_data_demodulated_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			free(pgs_data_noised_signals);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			free(pgs_data_modulated_signals);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_premodulated_blocks, pgs_data_premodulated_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_encoded_blocks, pgs_data_encoded_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_blocks(pgs_data_source_blocks, pgs_data_source_blocks_count);
-		}
-#if defined (_OPENMP)
-#pragma omp section
-#endif
-		{
-			pgb_destroy_block(pgs_data_source);
-		}
-	}
-	}
+	free(pgs_errors);
+	free(pgs_hsquares_times);
+	free(pgs_hsquares);
 
+	pgm_done_tables();
 	pgf_done_syndromes();
 	pgf_done_polynomes();
+	pgt_done_threads();
 
 	exit(EX_OK);
 }
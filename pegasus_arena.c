@@ -0,0 +1,126 @@
+/**
+ * @author Oleksandr Natalenko aka post-factum <oleksandr@natalenko.name>
+ *
+ * @section LICENSE
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * pegasus — digital channel simulator, arena file
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "pegasus_common_types.h"
+
+#include "pegasus_panic.h"
+#include "pegasus_tools.h"
+
+#include "pegasus_arena.h"
+
+static pgs_slab_t* pga_create_slab(size_t _size, pgs_slab_t* _next)
+{
+	void* pointer = NULL;
+	if (unlikely(posix_memalign(&pointer, PGA_ALIGNMENT, PGA_ALIGN(sizeof(pgs_slab_t)) + _size) != 0))
+		pgp_malloc();
+
+	pgs_slab_t* ret = pointer;
+	ret->data = (char*)pointer + PGA_ALIGN(sizeof(pgs_slab_t));
+	ret->size = _size;
+	ret->used = 0;
+	ret->next = _next;
+
+	return ret;
+}
+
+static void pga_destroy_slabs(pgs_slab_t* _slab)
+{
+	while (_slab != NULL)
+	{
+		pgs_slab_t* next = _slab->next;
+		free(_slab);
+		_slab = next;
+	}
+}
+
+pgs_arena_t* pga_create()
+{
+	return pgt_alloc_aligned(1, sizeof(pgs_arena_t));
+}
+
+void pga_done(pgs_arena_t* _arena)
+{
+	pga_destroy_slabs(_arena->slabs);
+	_arena->slabs = NULL;
+	_arena->requested = 0;
+}
+
+void pga_destroy(pgs_arena_t* _arena)
+{
+	pga_done(_arena);
+	free(_arena);
+}
+
+void* pga_alloc(pgs_arena_t* _arena, size_t _items, size_t _item_size)
+{
+	size_t size = PGA_ALIGN(_items * _item_size);
+
+	if (unlikely(_arena->slabs == NULL || _arena->slabs->used + size > _arena->slabs->size))
+	{
+		size_t slab_size = _arena->slabs == NULL ? PGA_SLAB_SIZE : 2 * _arena->slabs->size;
+		if (slab_size < size)
+			slab_size = size;
+		_arena->slabs = pga_create_slab(slab_size, _arena->slabs);
+	}
+
+	void* ret = _arena->slabs->data + _arena->slabs->used;
+	_arena->slabs->used += size;
+	_arena->requested += size;
+	memset(ret, 0, size);
+
+	return ret;
+}
+
+pgs_signals_t pga_alloc_signals(pgs_arena_t* _arena, size_t _count)
+{
+	pgs_signals_t ret;
+
+	ret.i = pga_alloc(_arena, _count, sizeof(double));
+	ret.q = pga_alloc(_arena, _count, sizeof(double));
+
+	return ret;
+}
+
+pgs_signals_f_t pga_alloc_signals_f(pgs_arena_t* _arena, size_t _count)
+{
+	pgs_signals_f_t ret;
+
+	ret.i = pga_alloc(_arena, _count, sizeof(float));
+	ret.q = pga_alloc(_arena, _count, sizeof(float));
+
+	return ret;
+}
+
+void pga_reset(pgs_arena_t* _arena)
+{
+	if (unlikely(_arena->slabs != NULL && _arena->slabs->next != NULL))
+	{
+		pga_destroy_slabs(_arena->slabs);
+		_arena->slabs = pga_create_slab(_arena->requested, NULL);
+	}
+	else if (likely(_arena->slabs != NULL))
+		_arena->slabs->used = 0;
+
+	_arena->requested = 0;
+}
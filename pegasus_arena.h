@@ -0,0 +1,44 @@
+#pragma once
+
+#ifndef PEGASUS_ARENA_H
+#define PEGASUS_ARENA_H
+
+/**
+ * @author Oleksandr Natalenko aka post-factum <oleksandr@natalenko.name>
+ *
+ * @section LICENSE
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * pegasus — digital channel simulator, arena file header
+ */
+
+#include <stddef.h>
+
+#include "pegasus_common_types.h"
+
+#define PGA_ALIGNMENT	64
+#define PGA_SLAB_SIZE	(1ULL << 20)
+
+#define PGA_ALIGN(_size)	(((_size) + PGA_ALIGNMENT - 1) / PGA_ALIGNMENT * PGA_ALIGNMENT)
+
+pgs_arena_t* pga_create();
+void pga_done(pgs_arena_t* _arena);
+void pga_destroy(pgs_arena_t* _arena);
+void* pga_alloc(pgs_arena_t* _arena, size_t _items, size_t _item_size);
+pgs_signals_t pga_alloc_signals(pgs_arena_t* _arena, size_t _count);
+pgs_signals_f_t pga_alloc_signals_f(pgs_arena_t* _arena, size_t _count);
+void pga_reset(pgs_arena_t* _arena);
+
+#endif /* PEGASUS_ARENA_H */
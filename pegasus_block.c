@@ -25,101 +25,150 @@
 
 #include "pegasus_common_types.h"
 
+#include "pegasus_arena.h"
 #include "pegasus_panic.h"
 #include "pegasus_tools.h"
 
 #include "pegasus_block.h"
 
-pgs_block_t* pgb_create_blocks(unsigned long long _count, unsigned long long _alignment)
+static pgs_block_t* pgb_layout_blocks(void* _memory, unsigned long long _count, unsigned long long _alignment)
 {
-	pgs_block_t* ret = pgt_alloc(_count, sizeof(pgs_block_t));
+	pgs_block_t* ret = _memory;
+	uint64_t* words = (uint64_t*)((char*)_memory + PGA_ALIGN(_count * sizeof(pgs_block_t)));
 	for (unsigned long long i = 0; i < _count; i++)
 	{
-		ret[i].chunk = pgt_alloc(_alignment, sizeof(pgs_bit_t));
+		ret[i].chunk = words + i * PGB_WORDS(_alignment);
 		ret[i].bits_count = _alignment;
 	}
 	return ret;
 }
 
+static size_t pgb_blocks_size(unsigned long long _count, unsigned long long _alignment)
+{
+	return PGA_ALIGN(_count * sizeof(pgs_block_t)) + _count * PGB_WORDS(_alignment) * sizeof(uint64_t);
+}
+
+pgs_block_t* pgb_create_blocks(unsigned long long _count, unsigned long long _alignment)
+{
+	return pgb_layout_blocks(pgt_alloc(1, pgb_blocks_size(_count, _alignment)), _count, _alignment);
+}
+
+pgs_block_t* pgb_alloc_blocks(pgs_arena_t* _arena, unsigned long long _count, unsigned long long _alignment)
+{
+	return pgb_layout_blocks(pga_alloc(_arena, 1, pgb_blocks_size(_count, _alignment)), _count, _alignment);
+}
+
 pgs_block_t* pgb_create_block(unsigned long long _alignment)
 {
 	return pgb_create_blocks(1, _alignment);
 }
 
-void pgb_destroy_blocks(pgs_block_t* _blocks, unsigned long long _amount)
+void pgb_destroy_blocks(pgs_block_t* _blocks)
 {
-	for (unsigned long long i = 0; i < _amount; i++)
-		free(_blocks[i].chunk);
 	free(_blocks);
 }
 
 void pgb_destroy_block(pgs_block_t* _block)
 {
-	pgb_destroy_blocks(_block, 1);
+	pgb_destroy_blocks(_block);
 }
 
 inline unsigned int pgb_get_bit(pgs_block_t* _block, unsigned long long _index)
 {
-	return _block->chunk[_index].bit;
+	return (_block->chunk[PGB_WORD(_index)] >> PGB_SHIFT(_index)) & 1ULL;
 }
 
 inline void pgb_set_bit(pgs_block_t* _block, unsigned long long _index, unsigned int _bit)
 {
-	_block->chunk[_index].bit = _bit;
+	_block->chunk[PGB_WORD(_index)] &= ~(1ULL << PGB_SHIFT(_index));
+	_block->chunk[PGB_WORD(_index)] |= (uint64_t)(_bit & 1) << PGB_SHIFT(_index);
 }
 
 inline void pgb_xor_bit(pgs_block_t* _block, unsigned long long _index, unsigned int _bit)
 {
-	_block->chunk[_index].bit ^= _bit;
+	_block->chunk[PGB_WORD(_index)] ^= (uint64_t)(_bit & 1) << PGB_SHIFT(_index);
 }
 
 inline void pgb_copyxor_bit(pgs_block_t* _target, unsigned long long _target_index,
 		pgs_block_t* _source, unsigned long long _source_index)
 
 {
-	_target->chunk[_target_index].bit ^= _source->chunk[_source_index].bit;
+	pgb_xor_bit(_target, _target_index, pgb_get_bit(_source, _source_index));
 }
 
 inline void pgb_copy_bit(pgs_block_t* _target, unsigned long long _target_index,
 		pgs_block_t* _source, unsigned long long _source_index)
 {
-	_target->chunk[_target_index].bit = _source->chunk[_source_index].bit;
+	pgb_set_bit(_target, _target_index, pgb_get_bit(_source, _source_index));
 }
 
 inline void pgb_flip_bit(pgs_block_t* _block, unsigned long long _index)
 {
-	_block->chunk[_index].bit = ~_block->chunk[_index].bit;
+	_block->chunk[PGB_WORD(_index)] ^= 1ULL << PGB_SHIFT(_index);
 }
 
 inline unsigned int pgb_cmp_bit(pgs_block_t* _block1, unsigned long long _index1,
 		pgs_block_t* _block2, unsigned long long _index2)
 {
-	return _block1->chunk[_index1].bit == _block2->chunk[_index2].bit;
+	return pgb_get_bit(_block1, _index1) == pgb_get_bit(_block2, _index2);
 }
 
+unsigned long long pgb_get_bits(pgs_block_t* _block,
+		unsigned long long _index,
+		unsigned long long _count)
+{
+	if (unlikely(_count == 0))
+		return 0;
 
-unsigned long long pgb_block_to_ull(pgs_block_t* _block)
+	unsigned long long word = PGB_WORD(_index);
+	unsigned long long offset = PGB_OFFSET(_index);
+	uint64_t ret = _block->chunk[word] << offset;
+	if (offset + _count > PGS_UINT64_SIZE)
+		ret |= _block->chunk[word + 1] >> (PGS_UINT64_SIZE - offset);
+
+	return ret >> (PGS_UINT64_SIZE - _count);
+}
+
+void pgb_set_bits(pgs_block_t* _block,
+		unsigned long long _index,
+		unsigned long long _count,
+		unsigned long long _value)
 {
-	unsigned long long ret = 0;
+	if (unlikely(_count == 0))
+		return;
+
+	unsigned long long word = PGB_WORD(_index);
+	unsigned long long offset = PGB_OFFSET(_index);
+	uint64_t mask = PGB_HEAD_MASK(_count);
+	uint64_t value = (uint64_t)_value << (PGS_UINT64_SIZE - _count);
+	_block->chunk[word] = (_block->chunk[word] & ~(mask >> offset)) | (value >> offset);
+	if (offset + _count > PGS_UINT64_SIZE)
+		_block->chunk[word + 1] = (_block->chunk[word + 1] & ~(mask << (PGS_UINT64_SIZE - offset))) |
+			(value << (PGS_UINT64_SIZE - offset));
+}
 
-	for (unsigned long long i = 0; i < _block->bits_count; i++)
-		if (pgb_get_bit(_block, i))
-			ret += (1ULL << (_block->bits_count - i - 1));
+unsigned long long pgb_block_to_ull(pgs_block_t* _block)
+{
+	if (unlikely(_block->bits_count > PGS_UINT64_SIZE))
+		pgp_range();
 
-	return ret;
+	return pgb_get_bits(_block, 0, _block->bits_count);
 }
 
 void pgb_ull_to_block(pgs_block_t* _block,
 		unsigned long long _value)
 {
-	for (unsigned long long i = 0; i < _block->bits_count; i++)
-		pgb_set_bit(_block, _block->bits_count - i - 1, (_value & ( 1ULL << i )) >> i);
+	if (unlikely(_block->bits_count > PGS_UINT64_SIZE))
+		pgp_range();
+
+	pgb_set_bits(_block, 0, _block->bits_count, _value);
 }
 
 void pgb_binary_string_to_block(pgs_block_t* _block,
 		const char* _binary_string)
 {
-	for (unsigned long long i = 0; i < strlen(_binary_string); i++)
+	unsigned long long length = strlen(_binary_string);
+	for (unsigned long long i = 0; i < length; i++)
 		pgb_set_bit(_block, i, _binary_string[i] == '1' ? 1 : 0);
 }
 
@@ -140,8 +189,12 @@ void pgb_divmod2(pgs_block_t** _quotient, pgs_block_t* _dividend, pgs_block_t* _
 
 void pgb_xor(pgs_block_t* _target, pgs_block_t* _pattern)
 {
-	for (unsigned long long i = 0; i < _target->bits_count; i++)
-		pgb_copyxor_bit(_target, i, _pattern, i);
+	unsigned long long words_count = _target->bits_count / PGS_UINT64_SIZE;
+	unsigned long long extra_bits = PGB_OFFSET(_target->bits_count);
+	for (unsigned long long i = 0; i < words_count; i++)
+		_target->chunk[i] ^= _pattern->chunk[i];
+	if (extra_bits > 0)
+		_target->chunk[words_count] ^= _pattern->chunk[words_count] & PGB_HEAD_MASK(extra_bits);
 }
 
 unsigned int pgb_multixor(pgs_block_t* _block, unsigned long long* _bits, unsigned long long _length)
@@ -162,8 +215,26 @@ void pgb_copy(pgs_block_t* _destination,
 			_source_index + _amount > _source->bits_count))
 		pgp_range();
 
-	for (unsigned long long i = _destination_index; i < _destination_index + _amount; i++)
-		pgb_copy_bit(_destination, i, _source, _source_index + i - _destination_index);
+	if (PGB_OFFSET(_destination_index) == 0 && PGB_OFFSET(_source_index) == 0)
+	{
+		unsigned long long words_count = _amount / PGS_UINT64_SIZE;
+		memcpy(&_destination->chunk[PGB_WORD(_destination_index)],
+				&_source->chunk[PGB_WORD(_source_index)],
+				words_count * sizeof(uint64_t));
+		_destination_index += words_count * PGS_UINT64_SIZE;
+		_source_index += words_count * PGS_UINT64_SIZE;
+		_amount -= words_count * PGS_UINT64_SIZE;
+	}
+
+	while (_amount > 0)
+	{
+		unsigned long long count = _amount < PGS_UINT64_SIZE ? _amount : PGS_UINT64_SIZE;
+		pgb_set_bits(_destination, _destination_index, count,
+				pgb_get_bits(_source, _source_index, count));
+		_destination_index += count;
+		_source_index += count;
+		_amount -= count;
+	}
 }
 
 void pgb_show_blocks(pgs_block_t* _block, unsigned long long _count)
@@ -26,10 +26,21 @@
 
 #include "pegasus_common_types.h"
 
+/*
+ * Bits are packed MSB-first into 64-bit words: bit 0 of a block is the most
+ * significant bit of its first word. Unused bits of the last word stay zero.
+ */
+#define PGB_WORDS(_bits)	(((_bits) + PGS_UINT64_SIZE - 1) / PGS_UINT64_SIZE)
+#define PGB_WORD(_index)	((_index) / PGS_UINT64_SIZE)
+#define PGB_OFFSET(_index)	((_index) % PGS_UINT64_SIZE)
+#define PGB_SHIFT(_index)	(PGS_UINT64_SIZE - 1 - PGB_OFFSET(_index))
+#define PGB_HEAD_MASK(_bits)	((_bits) == 0 ? 0ULL : PGS_UINT64_MAX << (PGS_UINT64_SIZE - (_bits)))
+
 pgs_block_t* pgb_create_blocks(unsigned long long _count, unsigned long long _alignment);
+pgs_block_t* pgb_alloc_blocks(pgs_arena_t* _arena, unsigned long long _count, unsigned long long _alignment);
 pgs_block_t* pgb_create_block(unsigned long long _alignment);
 void pgb_destroy_block(pgs_block_t* _block);
-void pgb_destroy_blocks(pgs_block_t* _blocks, unsigned long long _amount);
+void pgb_destroy_blocks(pgs_block_t* _blocks);
 unsigned int pgb_get_bit(pgs_block_t* _block, unsigned long long _index);
 void pgb_set_bit(pgs_block_t* _block, unsigned long long _index, unsigned int _bit);
 void pgb_xor_bit(pgs_block_t* _block, unsigned long long _index, unsigned int _bit);
@@ -40,6 +51,13 @@ void pgb_copy_bit(pgs_block_t* _target, unsigned long long _target_index,
 void pgb_flip_bit(pgs_block_t* _block, unsigned long long _index);
 unsigned int pgb_cmp_bit(pgs_block_t* _block1, unsigned long long _index1,
 		pgs_block_t* _block2, unsigned long long _index2);
+unsigned long long pgb_get_bits(pgs_block_t* _block,
+		unsigned long long _index,
+		unsigned long long _count);
+void pgb_set_bits(pgs_block_t* _block,
+		unsigned long long _index,
+		unsigned long long _count,
+		unsigned long long _value);
 unsigned long long pgb_block_to_ull(pgs_block_t* _block);
 void pgb_ull_to_block(pgs_block_t* _block,
 		unsigned long long _value);
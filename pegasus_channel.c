@@ -28,6 +28,7 @@
 #include "pegasus_common_strings.h"
 #include "pegasus_common_types.h"
 
+#include "pegasus_arena.h"
 #include "pegasus_panic.h"
 #include "pegasus_random.h"
 #include "pegasus_tools.h"
@@ -51,76 +52,325 @@ char* pgc_channel_to_string(unsigned int _channel)
 	}
 }
 
-static void pgc_add_awgn_noise(pgs_signal_t* _noised_signal,
-		pgs_signal_t* _clean_signal,
-		double _hsquare)
+unsigned long long pgc_draw_noise(pgs_signals_t* _noise,
+		pgs_signals_t* _fading,
+		unsigned long long _signals_count,
+		unsigned int _channel,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
+{
+	*_noise = pga_alloc_signals(_arena, _signals_count);
+	__pgr_fill_gauss(_context, _noise->i, _signals_count, 1.0);
+	__pgr_fill_gauss(_context, _noise->q, _signals_count, 1.0);
+
+	switch (_channel)
+	{
+		case PGC_AWGN:
+			_fading->i = NULL;
+			_fading->q = NULL;
+			break;
+		case PGC_RAYLEIGH:
+			*_fading = pga_alloc_signals(_arena, _signals_count);
+			__pgr_fill_gauss(_context, _fading->i, _signals_count, PGC_SIGMA1);
+			__pgr_fill_gauss(_context, _fading->q, _signals_count, PGC_SIGMA1);
+			break;
+		default:
+			pgp_switch_default();
+			break;
+	}
+
+	return _signals_count;
+}
+
+unsigned long long pgc_apply_noise(pgs_signals_t* _noised_signals,
+		pgs_signals_t* _modulated_signals,
+		pgs_signals_t* _noise,
+		pgs_signals_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_arena_t* _arena)
 {
-	_noised_signal->i = _clean_signal->i + PGC_SIGMA2 * pgr_get_gauss();
-	_noised_signal->q = _clean_signal->q + PGC_SIGMA2 * pgr_get_gauss();
+	if (unlikely(_modulated_signals == NULL || _noise == NULL || _noise->i == NULL))
+		return 0;
+
+	double sigma = PGC_SIGMA2;
+	*_noised_signals = pga_alloc_signals(_arena, _modulated_signals_count);
+	double* restrict noised_i = _noised_signals->i;
+	double* restrict noised_q = _noised_signals->q;
+	const double* restrict modulated_i = _modulated_signals->i;
+	const double* restrict modulated_q = _modulated_signals->q;
+	const double* restrict noise_i = _noise->i;
+	const double* restrict noise_q = _noise->q;
+
+	switch (_channel)
+	{
+		case PGC_AWGN:
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+			for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+			{
+				noised_i[i] = modulated_i[i] + sigma * noise_i[i];
+				noised_q[i] = modulated_q[i] + sigma * noise_q[i];
+			}
+			break;
+		case PGC_RAYLEIGH:
+		{
+			if (unlikely(_fading == NULL || _fading->i == NULL))
+				pgp_null();
+			const double* restrict fading_i = _fading->i;
+			const double* restrict fading_q = _fading->q;
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+			for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+			{
+				double h_R = fading_i[i];
+				double h_I = fading_q[i];
+				double y_R = h_R * modulated_i[i] - h_I * modulated_q[i] + sigma * noise_i[i];
+				double y_I = h_I * modulated_i[i] + h_R * modulated_q[i] + sigma * noise_q[i];
+				double reciprocal = 1.0 / (h_R * h_R + h_I * h_I);
+
+				noised_i[i] = (y_R * h_R + y_I * h_I) * reciprocal;
+				noised_q[i] = (y_I * h_R - y_R * h_I) * reciprocal;
+			}
+			break;
+		}
+		default:
+			pgp_switch_default();
+			break;
+	}
+
+	return _modulated_signals_count;
 }
 
-static void pgc_add_rayleigh_noise(pgs_signal_t* _noised_signal,
-		pgs_signal_t* _clean_signal,
-		double _hsquare)
+unsigned long long pgc_add_noise_soa(pgs_signals_t* _noised_signals,
+		pgs_signals_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
 {
-	double h_R, h_I, n_R, n_I, y_R, y_I, divisor, dividend_R, dividend_I;
+	pgs_signals_t noise, fading;
 
-	h_R = PGC_SIGMA1 * pgr_get_gauss();
-	h_I = PGC_SIGMA1 * pgr_get_gauss();
-	n_R = PGC_SIGMA2 * pgr_get_gauss();
-	n_I = PGC_SIGMA2 * pgr_get_gauss();
+	if (unlikely(_modulated_signals == NULL))
+		return 0;
 
-	y_R = h_R * _clean_signal->i - h_I * _clean_signal->q + n_R;
-	y_I = h_I * _clean_signal->i + h_R * _clean_signal->q + n_I;
+	pgc_draw_noise(&noise, &fading, _modulated_signals_count, _channel, _context, _arena);
 
-	divisor = pow(h_R, 2) + pow(h_I, 2);
-	dividend_R = y_R * h_R + y_I * h_I;
-	dividend_I = y_I * h_R - y_R * h_I;
+	return pgc_apply_noise(_noised_signals,
+			_modulated_signals,
+			&noise,
+			&fading,
+			_modulated_signals_count,
+			_channel,
+			_hsquare,
+			_arena);
+}
 
-	_noised_signal->i = dividend_R / divisor;
-	_noised_signal->q = dividend_I / divisor;
+static void pgc_apply_awgn_noise(pgs_signal_t* restrict _noised_signals,
+		const pgs_signal_t* restrict _modulated_signals,
+		const double* restrict _noise_i,
+		const double* restrict _noise_q,
+		unsigned long long _modulated_signals_count,
+		double _sigma)
+{
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+	{
+		_noised_signals[i].i = _modulated_signals[i].i + _sigma * _noise_i[i];
+		_noised_signals[i].q = _modulated_signals[i].q + _sigma * _noise_q[i];
+	}
 }
 
-static void pgc_add_noise_to_signal(pgs_signal_t* _noised_signal,
-		pgs_signal_t* _clean_signal,
-		unsigned long long _channel,
-		double _hsquare)
+static void pgc_apply_rayleigh_noise(pgs_signal_t* restrict _noised_signals,
+		const pgs_signal_t* restrict _modulated_signals,
+		const double* restrict _noise_i,
+		const double* restrict _noise_q,
+		const double* restrict _fading_i,
+		const double* restrict _fading_q,
+		unsigned long long _modulated_signals_count,
+		double _sigma)
 {
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+	{
+		double h_R = _fading_i[i];
+		double h_I = _fading_q[i];
+		double y_R = h_R * _modulated_signals[i].i - h_I * _modulated_signals[i].q + _sigma * _noise_i[i];
+		double y_I = h_I * _modulated_signals[i].i + h_R * _modulated_signals[i].q + _sigma * _noise_q[i];
+		double reciprocal = 1.0 / (h_R * h_R + h_I * h_I);
+
+		_noised_signals[i].i = (y_R * h_R + y_I * h_I) * reciprocal;
+		_noised_signals[i].q = (y_I * h_R - y_R * h_I) * reciprocal;
+	}
+}
+
+unsigned long long pgc_add_noise(pgs_signal_t** _noised_signals,
+		pgs_signal_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_arena_t* _arena)
+{
+	pgs_signals_t noise, fading;
+
+	if (unlikely(_modulated_signals == NULL))
+		return 0;
+
+	double sigma = PGC_SIGMA2;
+	pgc_draw_noise(&noise, &fading, _modulated_signals_count, _channel, pgt_get_context(), _arena);
+	pgs_signal_t* noised_signals = pga_alloc(_arena, _modulated_signals_count, sizeof(pgs_signal_t));
+	*_noised_signals = noised_signals;
+
 	switch (_channel)
 	{
 		case PGC_AWGN:
-			pgc_add_awgn_noise(_noised_signal, _clean_signal, _hsquare);
+			pgc_apply_awgn_noise(noised_signals,
+					_modulated_signals,
+					noise.i,
+					noise.q,
+					_modulated_signals_count,
+					sigma);
 			break;
 		case PGC_RAYLEIGH:
-			pgc_add_rayleigh_noise(_noised_signal, _clean_signal, _hsquare);
+			pgc_apply_rayleigh_noise(noised_signals,
+					_modulated_signals,
+					noise.i,
+					noise.q,
+					fading.i,
+					fading.q,
+					_modulated_signals_count,
+					sigma);
 			break;
 		default:
 			pgp_switch_default();
 			break;
 	}
+
+	return _modulated_signals_count;
 }
 
-unsigned long long pgc_add_noise(pgs_signal_t** _noised_signals,
-		pgs_signal_t* _modulated_signals,
+unsigned long long pgc_draw_noise_f(pgs_signals_f_t* _noise,
+		pgs_signals_f_t* _fading,
+		unsigned long long _signals_count,
+		unsigned int _channel,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
+{
+	*_noise = pga_alloc_signals_f(_arena, _signals_count);
+	__pgr_fill_gauss_f(_context, _noise->i, _signals_count, 1.0f);
+	__pgr_fill_gauss_f(_context, _noise->q, _signals_count, 1.0f);
+
+	switch (_channel)
+	{
+		case PGC_AWGN:
+			_fading->i = NULL;
+			_fading->q = NULL;
+			break;
+		case PGC_RAYLEIGH:
+			*_fading = pga_alloc_signals_f(_arena, _signals_count);
+			__pgr_fill_gauss_f(_context, _fading->i, _signals_count, (float)PGC_SIGMA1);
+			__pgr_fill_gauss_f(_context, _fading->q, _signals_count, (float)PGC_SIGMA1);
+			break;
+		default:
+			pgp_switch_default();
+			break;
+	}
+
+	return _signals_count;
+}
+
+unsigned long long pgc_apply_noise_f(pgs_signals_f_t* _noised_signals,
+		pgs_signals_f_t* _modulated_signals,
+		pgs_signals_f_t* _noise,
+		pgs_signals_f_t* _fading,
 		unsigned long long _modulated_signals_count,
 		unsigned int _channel,
-		double _hsquare)
+		double _hsquare,
+		pgs_arena_t* _arena)
 {
-	if (unlikely(_modulated_signals == NULL))
+	if (unlikely(_modulated_signals == NULL || _noise == NULL || _noise->i == NULL))
 		return 0;
 
-	*_noised_signals = pgt_alloc(_modulated_signals_count, sizeof(pgs_signal_t));
+	float sigma = (float)PGC_SIGMA2;
+	*_noised_signals = pga_alloc_signals_f(_arena, _modulated_signals_count);
+	float* restrict noised_i = _noised_signals->i;
+	float* restrict noised_q = _noised_signals->q;
+	const float* restrict modulated_i = _modulated_signals->i;
+	const float* restrict modulated_q = _modulated_signals->q;
+	const float* restrict noise_i = _noise->i;
+	const float* restrict noise_q = _noise->q;
 
+	switch (_channel)
+	{
+		case PGC_AWGN:
 #if defined(_OPENMP)
 #pragma omp parallel for
 #endif
-	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
-		pgc_add_noise_to_signal(&((pgs_signal_t*)(*_noised_signals))[i],
-				&_modulated_signals[i],
-				_channel,
-				_hsquare);
+			for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+			{
+				noised_i[i] = modulated_i[i] + sigma * noise_i[i];
+				noised_q[i] = modulated_q[i] + sigma * noise_q[i];
+			}
+			break;
+		case PGC_RAYLEIGH:
+		{
+			if (unlikely(_fading == NULL || _fading->i == NULL))
+				pgp_null();
+			const float* restrict fading_i = _fading->i;
+			const float* restrict fading_q = _fading->q;
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+			for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+			{
+				float h_R = fading_i[i];
+				float h_I = fading_q[i];
+				float y_R = h_R * modulated_i[i] - h_I * modulated_q[i] + sigma * noise_i[i];
+				float y_I = h_I * modulated_i[i] + h_R * modulated_q[i] + sigma * noise_q[i];
+				float reciprocal = 1.0f / (h_R * h_R + h_I * h_I);
 
-	return _modulated_signals_count;
+				noised_i[i] = (y_R * h_R + y_I * h_I) * reciprocal;
+				noised_q[i] = (y_I * h_R - y_R * h_I) * reciprocal;
+			}
+			break;
+		}
+		default:
+			pgp_switch_default();
+			break;
+	}
 
+	return _modulated_signals_count;
 }
 
+unsigned long long pgc_add_noise_soa_f(pgs_signals_f_t* _noised_signals,
+		pgs_signals_f_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
+{
+	pgs_signals_f_t noise, fading;
+
+	if (unlikely(_modulated_signals == NULL))
+		return 0;
+
+	pgc_draw_noise_f(&noise, &fading, _modulated_signals_count, _channel, _context, _arena);
+
+	return pgc_apply_noise_f(_noised_signals,
+			_modulated_signals,
+			&noise,
+			&fading,
+			_modulated_signals_count,
+			_channel,
+			_hsquare,
+			_arena);
+}
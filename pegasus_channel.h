@@ -40,7 +40,50 @@ unsigned long long pgc_add_noise(pgs_signal_t** _noised_signals,
 		pgs_signal_t* _modulated_signals,
 		unsigned long long _modulated_signals_count,
 		unsigned int _channel,
-		double _hsquare);
+		double _hsquare,
+		pgs_arena_t* _arena);
+unsigned long long pgc_add_noise_soa(pgs_signals_t* _noised_signals,
+		pgs_signals_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena);
+unsigned long long pgc_draw_noise(pgs_signals_t* _noise,
+		pgs_signals_t* _fading,
+		unsigned long long _signals_count,
+		unsigned int _channel,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena);
+unsigned long long pgc_apply_noise(pgs_signals_t* _noised_signals,
+		pgs_signals_t* _modulated_signals,
+		pgs_signals_t* _noise,
+		pgs_signals_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_arena_t* _arena);
+unsigned long long pgc_add_noise_soa_f(pgs_signals_f_t* _noised_signals,
+		pgs_signals_f_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena);
+unsigned long long pgc_draw_noise_f(pgs_signals_f_t* _noise,
+		pgs_signals_f_t* _fading,
+		unsigned long long _signals_count,
+		unsigned int _channel,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena);
+unsigned long long pgc_apply_noise_f(pgs_signals_f_t* _noised_signals,
+		pgs_signals_f_t* _modulated_signals,
+		pgs_signals_f_t* _noise,
+		pgs_signals_f_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_arena_t* _arena);
 
 #endif /* PEGASUS_CHANNEL_H */
 
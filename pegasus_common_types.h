@@ -25,6 +25,7 @@
  */
 
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __GNUC__
@@ -37,15 +38,15 @@
 
 #define PGS_UINT64_SIZE	(sizeof(uint64_t) * CHAR_BIT)
 #define PGS_UINT64_MAX 	((1ULL << (PGS_UINT64_SIZE - 1)) ^ ((1ULL << (PGS_UINT64_SIZE - 1)) - 1))
-
-typedef struct pgs_bit
-{
-	unsigned int bit:1;
-} __attribute__((packed)) pgs_bit_t;
+#define PGS_RNG_LANES	8
+#define PGS_SLICE_LANES	8
+#define PGS_CACHE_LINE	64
+#define PGS_REMAINDERS_SIZE	(1 << CHAR_BIT)
+#define PGS_CODEBOOK_SIZE	(1 << CHAR_BIT)
 
 typedef struct pgs_block
 {
-	pgs_bit_t* chunk;
+	uint64_t* chunk;
 	unsigned long long bits_count;
 	unsigned int used:1;
 } __attribute__((packed)) pgs_block_t;
@@ -55,5 +56,126 @@ typedef struct pgs_signal
 	double i, q;
 } pgs_signal_t;
 
+typedef struct pgs_rng
+{
+	uint32_t key[2];
+	uint32_t counter[4];
+} pgs_rng_t;
+
+typedef struct pgs_signals
+{
+	double* i;
+	double* q;
+} pgs_signals_t;
+
+typedef struct pgs_signals_f
+{
+	float* i;
+	float* q;
+} pgs_signals_f_t;
+
+typedef struct pgs_grid
+{
+	double origin;
+	double step;
+	unsigned long long side;
+	unsigned long long* offsets;
+	unsigned long long* candidates;
+} pgs_grid_t;
+
+typedef struct pgs_remainders
+{
+	unsigned long long degree;
+	uint64_t table[PGS_REMAINDERS_SIZE];
+} pgs_remainders_t;
+
+typedef struct pgs_codebook
+{
+	unsigned long long k;
+	unsigned long long n;
+	uint64_t codewords[PGS_CODEBOOK_SIZE];
+} pgs_codebook_t;
+
+typedef struct pgs_bch
+{
+	unsigned long long n;
+	unsigned long long k;
+	unsigned long long t;
+	unsigned long long parity;
+	unsigned long long words;
+	unsigned int* exp;
+	unsigned int* log;
+	uint64_t* generator;
+	uint64_t* remainders;
+} pgs_bch_t;
+
+typedef struct pgs_slice
+{
+	uint64_t lane[PGS_SLICE_LANES];
+} pgs_slice_t;
+
+typedef struct pgs_sliced_code
+{
+	unsigned long long n;
+	unsigned long long k;
+	unsigned long long parity;
+	uint64_t syndrome_rows[PGS_UINT64_SIZE];
+	uint64_t* corrections;
+} pgs_sliced_code_t;
+
+typedef struct pgs_slab
+{
+	char* data;
+	size_t size;
+	size_t used;
+	struct pgs_slab* next;
+} pgs_slab_t;
+
+typedef struct pgs_arena
+{
+	pgs_slab_t* slabs;
+	size_t requested;
+} pgs_arena_t;
+
+typedef struct pgs_errors
+{
+	unsigned long long bits, wrong_bits;
+	unsigned long long symbols, wrong_symbols;
+} pgs_errors_t;
+
+typedef struct pgs_context
+{
+	pgs_rng_t rng;
+	uint64_t seed;
+	pgs_arena_t arena;
+} __attribute__((aligned(PGS_CACHE_LINE))) pgs_context_t;
+
+typedef struct pgs_transmission
+{
+	unsigned long long sequence_length;
+	pgs_block_t* source;
+	pgs_block_t* source_blocks;
+	unsigned long long source_blocks_count;
+	pgs_block_t* premodulated_blocks;
+	unsigned long long premodulated_blocks_count;
+	pgs_signals_t modulated_signals;
+	unsigned long long modulated_signals_count;
+	pgs_signals_t noise;
+	pgs_signals_t fading;
+	pgs_signals_f_t modulated_signals_f;
+	pgs_signals_f_t noise_f;
+	pgs_signals_f_t fading_f;
+} pgs_transmission_t;
+
+typedef struct pgs_pipeline
+{
+	unsigned int source, fec, modulation, channel, error, precision;
+	unsigned int common_noise:1;
+	unsigned long long target_errors;
+	double confidence;
+	unsigned long long chunk_bits;
+	pgs_arena_t** transmit_arenas;
+} pgs_pipeline_t;
+
 #endif /* PEGASUS_COMMON_TYPES_H */
 
@@ -20,6 +20,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "pegasus_common_strings.h"
 #include "pegasus_common_types.h"
@@ -30,6 +31,205 @@
 
 #include "pegasus_fec.h"
 
+static void pgf_init_remainders(pgs_remainders_t* _remainders, pgs_block_t* _polynome)
+{
+	uint64_t polynome = pgb_block_to_ull(_polynome);
+	_remainders->degree = _polynome->bits_count - 1;
+
+	for (unsigned long long i = 0; i < PGS_REMAINDERS_SIZE; i++)
+	{
+		uint64_t remainder = (uint64_t)i << _remainders->degree;
+		for (unsigned long long j = CHAR_BIT; j-- > 0;)
+			if ((remainder >> (_remainders->degree + j)) & 1ULL)
+				remainder ^= polynome << j;
+		_remainders->table[i] = remainder;
+	}
+}
+
+static uint64_t pgf_remainder(pgs_remainders_t* _remainders, uint64_t _value, unsigned long long _bits_count)
+{
+	uint64_t mask = (1ULL << _remainders->degree) - 1;
+	unsigned long long head = _bits_count % CHAR_BIT;
+	uint64_t remainder = 0;
+
+	if (head > 0)
+	{
+		uint64_t dividend = _value >> (_bits_count - head);
+		remainder = _remainders->table[dividend >> _remainders->degree] ^ (dividend & mask);
+	}
+	for (unsigned long long shift = _bits_count - head; shift > 0; shift -= CHAR_BIT)
+	{
+		uint64_t dividend = (remainder << CHAR_BIT) | ((_value >> (shift - CHAR_BIT)) & (PGS_REMAINDERS_SIZE - 1));
+		remainder = _remainders->table[dividend >> _remainders->degree] ^ (dividend & mask);
+	}
+
+	return remainder;
+}
+
+static inline unsigned int pgf_gf_mul(pgs_bch_t* _bch, unsigned int _a, unsigned int _b)
+{
+	if (unlikely(_a == 0 || _b == 0))
+		return 0;
+
+	return _bch->exp[_bch->log[_a] + _bch->log[_b]];
+}
+
+static inline unsigned int pgf_gf_div(pgs_bch_t* _bch, unsigned int _a, unsigned int _b)
+{
+	if (unlikely(_a == 0))
+		return 0;
+
+	return _bch->exp[_bch->log[_a] + _bch->n - _bch->log[_b]];
+}
+
+static void pgf_bch_shift(uint64_t* _register, unsigned long long _words, unsigned long long _shift)
+{
+	for (unsigned long long i = 0; i + 1 < _words; i++)
+		_register[i] = (_register[i] << _shift) | (_register[i + 1] >> (PGS_UINT64_SIZE - _shift));
+	_register[_words - 1] <<= _shift;
+}
+
+static void pgf_bch_step(pgs_bch_t* _bch, uint64_t* _register, unsigned int _bit)
+{
+	unsigned int feedback = (unsigned int)(_register[0] >> (PGS_UINT64_SIZE - 1)) ^ _bit;
+	pgf_bch_shift(_register, _bch->words, 1);
+	if (feedback)
+		for (unsigned long long i = 0; i < _bch->words; i++)
+			_register[i] ^= _bch->generator[i];
+}
+
+static void pgf_bch_remainder(pgs_bch_t* _bch, pgs_block_t* _block, uint64_t* _remainder)
+{
+	unsigned long long head = _bch->k % CHAR_BIT;
+
+	memset(_remainder, 0, _bch->words * sizeof(uint64_t));
+	for (unsigned long long i = 0; i < head; i++)
+		pgf_bch_step(_bch, _remainder, pgb_get_bit(_block, i));
+	for (unsigned long long i = head; i < _bch->k; i += PGS_UINT64_SIZE)
+	{
+		unsigned long long count = _bch->k - i < PGS_UINT64_SIZE ? _bch->k - i : PGS_UINT64_SIZE;
+		uint64_t bits = (uint64_t)pgb_get_bits(_block, i, count) << (PGS_UINT64_SIZE - count);
+		for (unsigned long long j = 0; j < count; j += CHAR_BIT)
+		{
+			unsigned long long index = (_remainder[0] ^ bits) >> (PGS_UINT64_SIZE - CHAR_BIT);
+			uint64_t* entry = &_bch->remainders[index * _bch->words];
+			pgf_bch_shift(_remainder, _bch->words, CHAR_BIT);
+			for (unsigned long long w = 0; w < _bch->words; w++)
+				_remainder[w] ^= entry[w];
+			bits <<= CHAR_BIT;
+		}
+	}
+}
+
+static void pgf_init_bch(pgs_bch_t* _bch,
+		unsigned long long _field_power,
+		unsigned long long _fec_power,
+		unsigned long long _primitive,
+		unsigned long long _input_block_size)
+{
+	if (unlikely(_field_power > PGF_BCH_MAX_FIELD_POWER || _fec_power > PGF_BCH_MAX_FEC_POWER))
+		pgp_range();
+
+	_bch->n = (1ULL << _field_power) - 1;
+	_bch->k = _input_block_size;
+	_bch->t = _fec_power;
+	_bch->parity = _bch->n - _bch->k;
+	_bch->words = PGB_WORDS(_bch->parity);
+
+	_bch->exp = pgt_alloc(2 * _bch->n, sizeof(unsigned int));
+	_bch->log = pgt_alloc(_bch->n + 1, sizeof(unsigned int));
+	unsigned long long element = 1;
+	for (unsigned long long i = 0; i < _bch->n; i++)
+	{
+		_bch->exp[i] = _bch->exp[i + _bch->n] = element;
+		_bch->log[element] = i;
+		element <<= 1;
+		if (element & (1ULL << _field_power))
+			element ^= _primitive;
+	}
+	if (unlikely(element != 1))
+		pgp_range();
+
+	unsigned char* roots = pgt_alloc(_bch->n, sizeof(unsigned char));
+	unsigned int* generator = pgt_alloc(_bch->n + 1, sizeof(unsigned int));
+	unsigned long long degree = 0;
+	generator[0] = 1;
+	for (unsigned long long i = 1; i <= 2 * _bch->t; i++)
+		for (unsigned long long root = i; !roots[root]; root = root * 2 % _bch->n)
+		{
+			roots[root] = 1;
+			degree++;
+			for (unsigned long long j = degree; j > 0; j--)
+				generator[j] = generator[j - 1] ^ pgf_gf_mul(_bch, generator[j], _bch->exp[root]);
+			generator[0] = pgf_gf_mul(_bch, generator[0], _bch->exp[root]);
+		}
+	if (unlikely(degree != _bch->parity || _bch->parity < CHAR_BIT))
+		pgp_range();
+
+	_bch->generator = pgt_alloc(_bch->words, sizeof(uint64_t));
+	for (unsigned long long i = 0; i < _bch->parity; i++)
+	{
+		if (unlikely(generator[i] > 1))
+			pgp_range();
+		unsigned long long position = _bch->parity - 1 - i;
+		_bch->generator[PGB_WORD(position)] |= (uint64_t)generator[i] << PGB_SHIFT(position);
+	}
+	free(generator);
+	free(roots);
+
+	_bch->remainders = pgt_alloc(PGS_REMAINDERS_SIZE * _bch->words, sizeof(uint64_t));
+	for (unsigned long long i = 0; i < PGS_REMAINDERS_SIZE; i++)
+	{
+		uint64_t* entry = &_bch->remainders[i * _bch->words];
+		for (unsigned long long j = CHAR_BIT; j-- > 0;)
+			pgf_bch_step(_bch, entry, (i >> j) & 1);
+	}
+}
+
+static void pgf_done_bch(pgs_bch_t* _bch)
+{
+	free(_bch->remainders);
+	free(_bch->generator);
+	free(_bch->log);
+	free(_bch->exp);
+}
+
+static void pgf_init_codebook_hamming74(pgs_codebook_t* _codebook)
+{
+	_codebook->k = PGF_HAMMING74_INPUT_BLOCK_SIZE;
+	_codebook->n = PGF_HAMMING74_OUTPUT_BLOCK_SIZE;
+
+	for (unsigned long long i = 0; i < (1ULL << _codebook->k); i++)
+	{
+		uint64_t codeword = i;
+		for (unsigned long long j = 0; j < PGF_HAMMING74_FEC_SUFFIX; j++)
+		{
+			uint64_t parity = 0;
+			for (unsigned long long l = 0; l < PGF_HAMMING74_FEC_SUFFIX; l++)
+			{
+				unsigned long long fec_bit = PGF_HAMMING74_FEC_BITS[j][l];
+				parity ^= (i >> (_codebook->k - 1 - fec_bit)) & 1ULL;
+			}
+			codeword = (codeword << 1) | parity;
+		}
+		_codebook->codewords[i] = codeword;
+	}
+}
+
+static void pgf_init_codebook_crc(pgs_codebook_t* _codebook,
+		pgs_remainders_t* _remainders,
+		unsigned long long _output_block_size)
+{
+	_codebook->n = _output_block_size;
+	_codebook->k = _output_block_size - _remainders->degree;
+
+	for (unsigned long long i = 0; i < (1ULL << _codebook->k); i++)
+	{
+		uint64_t shifted = (uint64_t)i << _remainders->degree;
+		_codebook->codewords[i] = shifted | pgf_remainder(_remainders, shifted, _output_block_size);
+	}
+}
+
 void pgf_init_polynomes()
 {
 #if defined (_OPENMP)
@@ -38,10 +238,19 @@ void pgf_init_polynomes()
 	{
 #if defined (_OPENMP)
 #pragma omp section
+#endif
+		{
+			pgf_init_codebook_hamming74(&pgf_codebook_hamming74);
+		}
+
+#if defined (_OPENMP)
+#pragma omp section
 #endif
 		{
 			pgf_polynome_cyclic85 = pgb_create_block(PGF_CYCLIC85_FEC_SUFFIX + 1);
 			pgb_binary_string_to_block(pgf_polynome_cyclic85, PGF_CYCLIC85_POLYNOME);
+			pgf_init_remainders(&pgf_remainders_cyclic85, pgf_polynome_cyclic85);
+			pgf_init_codebook_crc(&pgf_codebook_cyclic85, &pgf_remainders_cyclic85, PGF_CYCLIC85_OUTPUT_BLOCK_SIZE);
 		}
 
 #if defined (_OPENMP)
@@ -50,6 +259,8 @@ void pgf_init_polynomes()
 		{
 			pgf_polynome_bch1557 = pgb_create_block(PGF_BCH1557_FEC_SUFFIX + 1);
 			pgb_binary_string_to_block(pgf_polynome_bch1557, PGF_BCH1557_POLYNOME);
+			pgf_init_remainders(&pgf_remainders_bch1557, pgf_polynome_bch1557);
+			pgf_init_codebook_crc(&pgf_codebook_bch1557, &pgf_remainders_bch1557, PGF_BCH1557_OUTPUT_BLOCK_SIZE);
 		}
 
 #if defined (_OPENMP)
@@ -58,68 +269,46 @@ void pgf_init_polynomes()
 		{
 			pgf_polynome_bch1575 = pgb_create_block(PGF_BCH1575_FEC_SUFFIX + 1);
 			pgb_binary_string_to_block(pgf_polynome_bch1575, PGF_BCH1575_POLYNOME);
+			pgf_init_remainders(&pgf_remainders_bch1575, pgf_polynome_bch1575);
+			pgf_init_codebook_crc(&pgf_codebook_bch1575, &pgf_remainders_bch1575, PGF_BCH1575_OUTPUT_BLOCK_SIZE);
 		}
-	}
-}
 
-void pgf_done_polynomes()
-{
-#if defined (_OPENMP)
-#pragma omp parallel sections
-#endif
-	{
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgb_destroy_block(pgf_polynome_cyclic85);
+			pgf_init_bch(&pgf_bch63457,
+					PGF_BCH63457_FIELD_POWER,
+					PGF_BCH63457_FEC_POWER,
+					PGF_BCH63457_PRIMITIVE,
+					PGF_BCH63457_INPUT_BLOCK_SIZE);
 		}
+
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgb_destroy_block(pgf_polynome_bch1557);
+			pgf_init_bch(&pgf_bch2552239,
+					PGF_BCH2552239_FIELD_POWER,
+					PGF_BCH2552239_FEC_POWER,
+					PGF_BCH2552239_PRIMITIVE,
+					PGF_BCH2552239_INPUT_BLOCK_SIZE);
 		}
+
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgb_destroy_block(pgf_polynome_bch1575);
+			pgf_init_bch(&pgf_bch102392321,
+					PGF_BCH102392321_FIELD_POWER,
+					PGF_BCH102392321_FEC_POWER,
+					PGF_BCH102392321_PRIMITIVE,
+					PGF_BCH102392321_INPUT_BLOCK_SIZE);
 		}
 	}
 }
 
-static void pgf_examine_error_vectors(pgs_block_t** _syndromes_table,
-		unsigned long long _block_size,
-		unsigned long long _fec_suffix,
-		unsigned long long _errors_count,
-		pgs_block_t* _fec_polynome,
-		const char* _test_sequence)
-{
-	*_syndromes_table = pgb_create_blocks(_fec_suffix, _block_size);
-	pgs_block_t* test_message = pgb_create_block(_block_size);
-	pgs_block_t* test_error = pgb_create_block(_block_size);
-	pgs_block_t* test_syndrome;
-	pgb_binary_string_to_block(test_message, _test_sequence);
-	for (unsigned long long i = (1ULL << _block_size) - 1; i > 0; i--)
-		if (unlikely(pgt_popcount(i) <= _errors_count))
-		{
-			pgb_ull_to_block(test_error, i);
-			pgb_xor(test_message, test_error);
-
-			pgb_divmod2(&test_syndrome, test_message, _fec_polynome);
-			unsigned long long index = pgb_block_to_ull(test_syndrome);
-			(*_syndromes_table)[index].used = 1;
-			pgb_copy(&(*_syndromes_table)[index], 0, test_error, 0, _block_size);
-			pgb_destroy_block(test_syndrome);
-
-			pgb_xor(test_message, test_error);
-		}
-	pgb_destroy_block(test_error);
-	pgb_destroy_block(test_message);
-}
-
-void pgf_init_syndromes()
+void pgf_done_polynomes()
 {
 #if defined (_OPENMP)
 #pragma omp parallel sections
@@ -129,63 +318,169 @@ void pgf_init_syndromes()
 #pragma omp section
 #endif
 		{
-			pgf_examine_error_vectors(&pgf_syndromes_cyclic85,
-					PGF_CYCLIC85_OUTPUT_BLOCK_SIZE,
-					PGF_CYCLIC85_VOLUME,
-					PGF_CYCLIC85_FEC_POWER,
-					pgf_polynome_cyclic85,
-					PGF_CYCLIC85_TEST);
+			pgb_destroy_block(pgf_polynome_cyclic85);
 		}
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgf_examine_error_vectors(&pgf_syndromes_bch1557,
-					PGF_BCH1557_OUTPUT_BLOCK_SIZE,
-					PGF_BCH1557_VOLUME,
-					PGF_BCH1557_FEC_POWER,
-					pgf_polynome_bch1557,
-					PGF_BCH1557_TEST);
+			pgb_destroy_block(pgf_polynome_bch1557);
 		}
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgf_examine_error_vectors(&pgf_syndromes_bch1575,
-					PGF_BCH1575_OUTPUT_BLOCK_SIZE,
-					PGF_BCH1575_VOLUME,
-					PGF_BCH1575_FEC_POWER,
-					pgf_polynome_bch1575,
-					PGF_BCH1575_TEST);
+			pgb_destroy_block(pgf_polynome_bch1575);
 		}
-	}
-}
-
-void pgf_done_syndromes()
-{
 #if defined (_OPENMP)
-#pragma omp parallel sections
+#pragma omp section
 #endif
-	{
+		{
+			pgf_done_bch(&pgf_bch63457);
+		}
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgb_destroy_blocks(pgf_syndromes_cyclic85, PGF_CYCLIC85_VOLUME);
+			pgf_done_bch(&pgf_bch2552239);
 		}
 #if defined (_OPENMP)
 #pragma omp section
 #endif
 		{
-			pgb_destroy_blocks(pgf_syndromes_bch1557, PGF_BCH1557_VOLUME);
+			pgf_done_bch(&pgf_bch102392321);
 		}
+	}
+}
+
+static void pgf_store_error_vector(uint64_t* _slot, uint64_t _error_vector, unsigned long long _weight)
+{
+	uint64_t stored = __atomic_load_n(_slot, __ATOMIC_RELAXED);
+	while (stored == 0 || (pgt_popcount(stored) == _weight && _error_vector < stored))
+		if (__atomic_compare_exchange_n(_slot, &stored, _error_vector, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			break;
+}
+
+static void pgf_examine_error_vectors(uint64_t** _syndromes_table,
+		unsigned long long _block_size,
+		unsigned long long _volume,
+		unsigned long long _errors_count,
+		pgs_remainders_t* _remainders)
+{
+	uint64_t single_syndromes[PGS_UINT64_SIZE];
+	for (unsigned long long i = 0; i < _block_size; i++)
+		single_syndromes[i] = pgf_remainder(_remainders, 1ULL << i, _block_size);
+
+	uint64_t* syndromes_table = pgt_alloc_aligned(_volume, sizeof(uint64_t));
+	for (unsigned long long weight = 1; weight <= _errors_count; weight++)
+	{
 #if defined (_OPENMP)
-#pragma omp section
+#pragma omp parallel for schedule(dynamic)
 #endif
+		for (unsigned long long top = weight - 1; top < _block_size; top++)
+		{
+			uint64_t rest = (1ULL << (weight - 1)) - 1;
+			for (;;)
+			{
+				uint64_t syndrome = single_syndromes[top];
+				for (uint64_t bits = rest; bits > 0; bits &= bits - 1)
+					syndrome ^= single_syndromes[__builtin_ctzll(bits)];
+				if (likely(syndrome > 0))
+					pgf_store_error_vector(&syndromes_table[syndrome], (1ULL << top) | rest, weight);
+
+				if (rest == 0)
+					break;
+				uint64_t lowest = rest & -rest;
+				uint64_t ripple = rest + lowest;
+				rest = (((ripple ^ rest) >> 2) / lowest) | ripple;
+				if (rest >= (1ULL << top))
+					break;
+			}
+		}
+	}
+	*_syndromes_table = syndromes_table;
+}
+
+static void pgf_init_sliced_hamming74(pgs_sliced_code_t* _code)
+{
+	_code->n = PGF_HAMMING74_OUTPUT_BLOCK_SIZE;
+	_code->k = PGF_HAMMING74_INPUT_BLOCK_SIZE;
+	_code->parity = PGF_HAMMING74_FEC_SUFFIX;
+	_code->corrections = pgt_alloc(1ULL << _code->parity, sizeof(uint64_t));
+
+	for (unsigned long long i = 0; i < PGF_HAMMING74_FEC_SUFFIX; i++)
+		for (unsigned long long j = 0; j < PGF_HAMMING74_INPUT_BLOCK_SIZE; j++)
 		{
-			pgb_destroy_blocks(pgf_syndromes_bch1575, PGF_BCH1575_VOLUME);
+			unsigned long long syndrome_bit = PGF_HAMMING74_SYNDROME_BITS[i][j];
+			_code->syndrome_rows[_code->parity - 1 - i] |= 1ULL << PGB_SHIFT(syndrome_bit);
 		}
+	for (unsigned long long i = 1; i <= PGF_HAMMING74_INPUT_BLOCK_SIZE; i++)
+		_code->corrections[i] = 1ULL << PGB_SHIFT(i - 1);
+}
+
+static void pgf_init_sliced_crc(pgs_sliced_code_t* _code,
+		uint64_t* _syndromes_table,
+		pgs_remainders_t* _remainders,
+		unsigned long long _output_block_size)
+{
+	_code->n = _output_block_size;
+	_code->parity = _remainders->degree;
+	_code->k = _code->n - _code->parity;
+	_code->corrections = pgt_alloc(1ULL << _code->parity, sizeof(uint64_t));
+
+	for (unsigned long long i = 0; i < _code->n; i++)
+	{
+		uint64_t syndrome = pgf_remainder(_remainders, 1ULL << (_code->n - 1 - i), _code->n);
+		for (unsigned long long j = 0; j < _code->parity; j++)
+			if ((syndrome >> j) & 1ULL)
+				_code->syndrome_rows[j] |= 1ULL << PGB_SHIFT(i);
 	}
+	for (unsigned long long i = 0; i < (1ULL << _code->parity); i++)
+		_code->corrections[i] = (_syndromes_table[i] << (PGS_UINT64_SIZE - _code->n)) & PGB_HEAD_MASK(_code->k);
+}
+
+void pgf_init_syndromes()
+{
+	pgf_examine_error_vectors(&pgf_syndromes_cyclic85,
+			PGF_CYCLIC85_OUTPUT_BLOCK_SIZE,
+			PGF_CYCLIC85_VOLUME,
+			PGF_CYCLIC85_FEC_POWER,
+			&pgf_remainders_cyclic85);
+	pgf_examine_error_vectors(&pgf_syndromes_bch1557,
+			PGF_BCH1557_OUTPUT_BLOCK_SIZE,
+			PGF_BCH1557_VOLUME,
+			PGF_BCH1557_FEC_POWER,
+			&pgf_remainders_bch1557);
+	pgf_examine_error_vectors(&pgf_syndromes_bch1575,
+			PGF_BCH1575_OUTPUT_BLOCK_SIZE,
+			PGF_BCH1575_VOLUME,
+			PGF_BCH1575_FEC_POWER,
+			&pgf_remainders_bch1575);
+
+	pgf_init_sliced_hamming74(&pgf_sliced_hamming74);
+	pgf_init_sliced_crc(&pgf_sliced_cyclic85,
+			pgf_syndromes_cyclic85,
+			&pgf_remainders_cyclic85,
+			PGF_CYCLIC85_OUTPUT_BLOCK_SIZE);
+	pgf_init_sliced_crc(&pgf_sliced_bch1557,
+			pgf_syndromes_bch1557,
+			&pgf_remainders_bch1557,
+			PGF_BCH1557_OUTPUT_BLOCK_SIZE);
+	pgf_init_sliced_crc(&pgf_sliced_bch1575,
+			pgf_syndromes_bch1575,
+			&pgf_remainders_bch1575,
+			PGF_BCH1575_OUTPUT_BLOCK_SIZE);
+}
+
+void pgf_done_syndromes()
+{
+	free(pgf_syndromes_cyclic85);
+	free(pgf_syndromes_bch1557);
+	free(pgf_syndromes_bch1575);
+	free(pgf_sliced_hamming74.corrections);
+	free(pgf_sliced_cyclic85.corrections);
+	free(pgf_sliced_bch1557.corrections);
+	free(pgf_sliced_bch1575.corrections);
 }
 
 char* pgf_to_string(unsigned int _fec)
@@ -207,6 +502,15 @@ char* pgf_to_string(unsigned int _fec)
 		case PGF_BCH1575:
 			return PGF_BCH1575_STRING;
 			break;
+		case PGF_BCH63457:
+			return PGF_BCH63457_STRING;
+			break;
+		case PGF_BCH2552239:
+			return PGF_BCH2552239_STRING;
+			break;
+		case PGF_BCH102392321:
+			return PGF_BCH102392321_STRING;
+			break;
 		default:
 			pgp_switch_default();
 			return PGS_CS_UNKNOWN;
@@ -233,6 +537,15 @@ unsigned long long pgf_get_input_block_size(unsigned int _fec)
 		case PGF_BCH1575:
 			return PGF_BCH1575_INPUT_BLOCK_SIZE;
 			break;
+		case PGF_BCH63457:
+			return PGF_BCH63457_INPUT_BLOCK_SIZE;
+			break;
+		case PGF_BCH2552239:
+			return PGF_BCH2552239_INPUT_BLOCK_SIZE;
+			break;
+		case PGF_BCH102392321:
+			return PGF_BCH102392321_INPUT_BLOCK_SIZE;
+			break;
 		default:
 			pgp_switch_default();
 			return PGF_UNKNOWN_INPUT_BLOCK_SIZE;
@@ -259,6 +572,15 @@ unsigned long long pgf_get_output_block_size(unsigned int _fec)
 		case PGF_BCH1575:
 			return PGF_BCH1575_OUTPUT_BLOCK_SIZE;
 			break;
+		case PGF_BCH63457:
+			return PGF_BCH63457_OUTPUT_BLOCK_SIZE;
+			break;
+		case PGF_BCH2552239:
+			return PGF_BCH2552239_OUTPUT_BLOCK_SIZE;
+			break;
+		case PGF_BCH102392321:
+			return PGF_BCH102392321_OUTPUT_BLOCK_SIZE;
+			break;
 		default:
 			pgp_switch_default();
 			return PGF_UNKNOWN_OUTPUT_BLOCK_SIZE;
@@ -266,28 +588,181 @@ unsigned long long pgf_get_output_block_size(unsigned int _fec)
 	}
 }
 
-static void pgf_encode_block_hamming74(pgs_block_t* _encoded_block,
-		pgs_block_t* _source_block)
+static pgs_sliced_code_t* pgf_get_sliced_code(unsigned int _fec)
 {
-	pgb_copy(_encoded_block, 0, _source_block, 0, PGF_HAMMING74_INPUT_BLOCK_SIZE);
-	for (unsigned long long i = 0; i < PGF_HAMMING74_FEC_SUFFIX; i++)
-		pgb_set_bit(_encoded_block, PGF_HAMMING74_INPUT_BLOCK_SIZE + i,
-			pgb_multixor(_source_block,
-					PGF_HAMMING74_FEC_BITS[i],
-					PGF_HAMMING74_FEC_SUFFIX));
+	switch (_fec)
+	{
+		case PGF_HAMMING74:
+			return &pgf_sliced_hamming74;
+			break;
+		case PGF_CYCLIC85:
+			return &pgf_sliced_cyclic85;
+			break;
+		case PGF_BCH1557:
+			return &pgf_sliced_bch1557;
+			break;
+		case PGF_BCH1575:
+			return &pgf_sliced_bch1575;
+			break;
+		default:
+			return NULL;
+			break;
+	}
+}
+
+static void pgf_load_slice(pgs_slice_t* _rows, pgs_block_t* _blocks, unsigned long long _count)
+{
+	for (unsigned long long i = 0; i < PGS_SLICE_LANES; i++)
+		for (unsigned long long j = 0; j < PGS_UINT64_SIZE; j++)
+		{
+			unsigned long long index = i * PGS_UINT64_SIZE + j;
+			_rows[j].lane[i] = index < _count ? _blocks[index].chunk[0] : 0;
+		}
+}
+
+static void pgf_store_slice(pgs_slice_t* _rows, pgs_block_t* _blocks, unsigned long long _count)
+{
+	for (unsigned long long i = 0; i < PGS_SLICE_LANES; i++)
+		for (unsigned long long j = 0; j < PGS_UINT64_SIZE && i * PGS_UINT64_SIZE + j < _count; j++)
+			_blocks[i * PGS_UINT64_SIZE + j].chunk[0] = _rows[j].lane[i];
 }
 
-static void pgf_encode_block_crc(pgs_block_t* _encoded_block,
+static void pgf_transpose_slice(pgs_slice_t* _rows)
+{
+	uint64_t mask = PGS_UINT64_MAX >> (PGS_UINT64_SIZE / 2);
+	for (unsigned long long i = PGS_UINT64_SIZE / 2; i != 0; i >>= 1, mask ^= mask << i)
+		for (unsigned long long j = 0; j < PGS_UINT64_SIZE; j = ((j | i) + 1) & ~i)
+			for (unsigned long long k = 0; k < PGS_SLICE_LANES; k++)
+			{
+				uint64_t swap = (_rows[j].lane[k] ^ (_rows[j | i].lane[k] >> i)) & mask;
+				_rows[j].lane[k] ^= swap;
+				_rows[j | i].lane[k] ^= swap << i;
+			}
+}
+
+static void pgf_xor_rows(pgs_slice_t* _target, pgs_slice_t* _rows, uint64_t _mask)
+{
+	for (unsigned long long i = 0; i < PGS_SLICE_LANES; i++)
+		_target->lane[i] = 0;
+	for (uint64_t bits = _mask; bits > 0; bits &= bits - 1)
+	{
+		pgs_slice_t* row = &_rows[PGS_UINT64_SIZE - 1 - __builtin_ctzll(bits)];
+		for (unsigned long long i = 0; i < PGS_SLICE_LANES; i++)
+			_target->lane[i] ^= row->lane[i];
+	}
+}
+
+static void pgf_correct_slice(pgs_sliced_code_t* _code,
+		pgs_slice_t* _syndromes,
+		pgs_slice_t* _errors,
+		pgs_slice_t* _match,
+		unsigned long long _bit,
+		unsigned long long _syndrome)
+{
+	if (_bit == _code->parity)
+	{
+		for (uint64_t bits = _code->corrections[_syndrome]; bits > 0; bits &= bits - 1)
+		{
+			pgs_slice_t* error = &_errors[PGS_UINT64_SIZE - 1 - __builtin_ctzll(bits)];
+			for (unsigned long long i = 0; i < PGS_SLICE_LANES; i++)
+				error->lane[i] |= _match->lane[i];
+		}
+		return;
+	}
+
+	pgs_slice_t match;
+	for (unsigned int value = 0; value < 2; value++)
+	{
+		uint64_t any = 0;
+		for (unsigned long long i = 0; i < PGS_SLICE_LANES; i++)
+		{
+			match.lane[i] = _match->lane[i] & (value ? _syndromes[_bit].lane[i] : ~_syndromes[_bit].lane[i]);
+			any |= match.lane[i];
+		}
+		if (any)
+			pgf_correct_slice(_code, _syndromes, _errors, &match, _bit + 1, _syndrome | ((unsigned long long)value << _bit));
+	}
+}
+
+static void pgf_decode_slice(pgs_sliced_code_t* _code,
+		pgs_block_t* _decoded_blocks,
+		pgs_block_t* _encoded_blocks,
+		unsigned long long _count)
+{
+	pgs_slice_t rows[PGS_UINT64_SIZE];
+	pgs_slice_t syndromes[PGS_UINT64_SIZE];
+	pgs_slice_t errors[PGS_UINT64_SIZE];
+	uint64_t any = 0;
+
+	pgf_load_slice(rows, _encoded_blocks, _count);
+	pgf_transpose_slice(rows);
+	for (unsigned long long i = 0; i < _code->parity; i++)
+	{
+		pgf_xor_rows(&syndromes[i], rows, _code->syndrome_rows[i]);
+		for (unsigned long long j = 0; j < PGS_SLICE_LANES; j++)
+			any |= syndromes[i].lane[j];
+	}
+	if (any)
+	{
+		pgs_slice_t match;
+		memset(errors, 0, _code->k * sizeof(pgs_slice_t));
+		memset(&match, 0xff, sizeof(pgs_slice_t));
+		pgf_correct_slice(_code, syndromes, errors, &match, 0, 0);
+		for (unsigned long long i = 0; i < _code->k; i++)
+			for (unsigned long long j = 0; j < PGS_SLICE_LANES; j++)
+				rows[i].lane[j] ^= errors[i].lane[j];
+	}
+	memset(&rows[_code->k], 0, (PGS_UINT64_SIZE - _code->k) * sizeof(pgs_slice_t));
+	pgf_transpose_slice(rows);
+	pgf_store_slice(rows, _decoded_blocks, _count);
+}
+
+static pgs_codebook_t* pgf_get_codebook(unsigned int _fec)
+{
+	switch (_fec)
+	{
+		case PGF_HAMMING74:
+			return &pgf_codebook_hamming74;
+			break;
+		case PGF_CYCLIC85:
+			return &pgf_codebook_cyclic85;
+			break;
+		case PGF_BCH1557:
+			return &pgf_codebook_bch1557;
+			break;
+		case PGF_BCH1575:
+			return &pgf_codebook_bch1575;
+			break;
+		default:
+			return NULL;
+			break;
+	}
+}
+
+unsigned int pgf_has_codebook(unsigned int _fec)
+{
+	return pgf_get_codebook(_fec) != NULL;
+}
+
+static void pgf_encode_block_codebook(pgs_block_t* _encoded_block,
 		pgs_block_t* _source_block,
-		pgs_block_t* _polynome,
-		unsigned long long _input_block_size,
-		unsigned long long _fec_suffix)
+		pgs_codebook_t* _codebook)
 {
-	pgs_block_t* syndrome;
-	pgb_copy(_encoded_block, 0, _source_block, 0, _input_block_size);
-	pgb_divmod2(&syndrome, _encoded_block, _polynome);
-	pgb_copy(_encoded_block, _input_block_size, syndrome, 0, _fec_suffix);
-	pgb_destroy_block(syndrome);
+	pgb_set_bits(_encoded_block, 0, _codebook->n, _codebook->codewords[pgb_get_bits(_source_block, 0, _codebook->k)]);
+}
+
+static void pgf_encode_block_bch(pgs_block_t* _encoded_block,
+		pgs_block_t* _source_block,
+		pgs_bch_t* _bch)
+{
+	uint64_t remainder[PGF_BCH_MAX_WORDS];
+	pgf_bch_remainder(_bch, _source_block, remainder);
+	pgb_copy(_encoded_block, 0, _source_block, 0, _bch->k);
+	for (unsigned long long i = 0; i < _bch->parity; i += PGS_UINT64_SIZE)
+	{
+		unsigned long long count = _bch->parity - i < PGS_UINT64_SIZE ? _bch->parity - i : PGS_UINT64_SIZE;
+		pgb_set_bits(_encoded_block, _bch->k + i, count, remainder[PGB_WORD(i)] >> (PGS_UINT64_SIZE - count));
+	}
 }
 
 static void pgf_encode_block(pgs_block_t* _encoded_block,
@@ -300,28 +775,19 @@ static void pgf_encode_block(pgs_block_t* _encoded_block,
 			pgb_copy(_encoded_block, 0, _source_block, 0, _source_block->bits_count);
 			break;
 		case PGF_HAMMING74:
-			pgf_encode_block_hamming74(_encoded_block, _source_block);
-			break;
 		case PGF_CYCLIC85:
-			pgf_encode_block_crc(_encoded_block,
-					_source_block,
-					pgf_polynome_cyclic85,
-					PGF_CYCLIC85_INPUT_BLOCK_SIZE,
-					PGF_CYCLIC85_FEC_SUFFIX);
-			break;
 		case PGF_BCH1557:
-			pgf_encode_block_crc(_encoded_block,
-					_source_block,
-					pgf_polynome_bch1557,
-					PGF_BCH1557_INPUT_BLOCK_SIZE,
-					PGF_BCH1557_FEC_SUFFIX);
-			break;
 		case PGF_BCH1575:
-			pgf_encode_block_crc(_encoded_block,
-					_source_block,
-					pgf_polynome_bch1575,
-					PGF_BCH1575_INPUT_BLOCK_SIZE,
-					PGF_BCH1575_FEC_SUFFIX);
+			pgf_encode_block_codebook(_encoded_block, _source_block, pgf_get_codebook(_fec));
+			break;
+		case PGF_BCH63457:
+			pgf_encode_block_bch(_encoded_block, _source_block, &pgf_bch63457);
+			break;
+		case PGF_BCH2552239:
+			pgf_encode_block_bch(_encoded_block, _source_block, &pgf_bch2552239);
+			break;
+		case PGF_BCH102392321:
+			pgf_encode_block_bch(_encoded_block, _source_block, &pgf_bch102392321);
 			break;
 		default:
 			pgp_switch_default();
@@ -332,12 +798,13 @@ static void pgf_encode_block(pgs_block_t* _encoded_block,
 unsigned long long pgf_encode_blocks(pgs_block_t** _encoded_blocks,
 		pgs_block_t* _source_blocks,
 		unsigned long long _source_blocks_count,
-		unsigned int _fec)
+		unsigned int _fec,
+		pgs_arena_t* _arena)
 {
 	if (unlikely(_source_blocks == NULL))
 		return 0;
 
-	*_encoded_blocks = pgb_create_blocks(_source_blocks_count, _fec == PGF_NONE ? _source_blocks[0].bits_count : pgf_get_output_block_size(_fec));
+	*_encoded_blocks = pgb_alloc_blocks(_arena, _source_blocks_count, _fec == PGF_NONE ? _source_blocks[0].bits_count : pgf_get_output_block_size(_fec));
 
 #if defined (_OPENMP)
 #pragma omp parallel for
@@ -349,37 +816,150 @@ unsigned long long pgf_encode_blocks(pgs_block_t** _encoded_blocks,
 	return _source_blocks_count;
 }
 
-static void pgf_decode_block_hamming74(pgs_block_t* _decoded_block,
-		pgs_block_t* _encoded_block)
+unsigned long long pgf_encode_stream(pgs_block_t** _encoded_stream,
+		pgs_block_t* _source_stream,
+		unsigned long long _bits_count,
+		unsigned int _fec,
+		pgs_arena_t* _arena)
 {
-	unsigned long long wrong_bit = 0;
-	pgs_block_t* syndrome_hamming74 = pgb_create_block(PGF_HAMMING74_FEC_SUFFIX);
-	for (unsigned long long i = 0; i < PGF_HAMMING74_FEC_SUFFIX; i++)
-		pgb_set_bit(syndrome_hamming74, i,
-			pgb_multixor(_encoded_block,
-					PGF_HAMMING74_SYNDROME_BITS[i],
-					PGF_HAMMING74_INPUT_BLOCK_SIZE));
-	wrong_bit = pgb_block_to_ull(syndrome_hamming74);
-	pgb_copy(_decoded_block, 0, _encoded_block, 0, PGF_HAMMING74_INPUT_BLOCK_SIZE);
-	if (unlikely(wrong_bit > 0 && wrong_bit <= PGF_HAMMING74_INPUT_BLOCK_SIZE))
-		pgb_flip_bit(_decoded_block, wrong_bit - 1);
-	pgb_destroy_block(syndrome_hamming74);
-}
-
-static void pgf_decode_block_crc(pgs_block_t* _decoded_block,
+	if (unlikely(_source_stream == NULL))
+		return 0;
+
+	pgs_codebook_t* codebook = pgf_get_codebook(_fec);
+	if (unlikely(codebook == NULL))
+		pgp_switch_default();
+
+	unsigned long long codewords_count = (_bits_count + codebook->k - 1) / codebook->k;
+	*_encoded_stream = pgb_alloc_blocks(_arena, 1, codewords_count * codebook->n);
+	uint64_t* encoded = (*_encoded_stream)->chunk;
+
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < codewords_count; i += PGS_UINT64_SIZE)
+	{
+		uint64_t* word = &encoded[i / PGS_UINT64_SIZE * codebook->n];
+		uint64_t accumulator = 0;
+		unsigned long long filled = 0;
+		unsigned long long end = i + PGS_UINT64_SIZE < codewords_count ? i + PGS_UINT64_SIZE : codewords_count;
+		for (unsigned long long j = i; j < end; j++)
+		{
+			unsigned long long offset = j * codebook->k;
+			unsigned long long count = _bits_count - offset < codebook->k ? _bits_count - offset : codebook->k;
+			uint64_t codeword = codebook->codewords[pgb_get_bits(_source_stream, offset, count) << (codebook->k - count)];
+			filled += codebook->n;
+			if (filled < PGS_UINT64_SIZE)
+				accumulator |= codeword << (PGS_UINT64_SIZE - filled);
+			else
+			{
+				filled -= PGS_UINT64_SIZE;
+				*word++ = accumulator | (codeword >> filled);
+				accumulator = filled == 0 ? 0 : codeword << (PGS_UINT64_SIZE - filled);
+			}
+		}
+		if (filled > 0)
+			*word = accumulator;
+	}
+
+	return 1;
+}
+
+static void pgf_decode_block_bch(pgs_block_t* _decoded_block,
 		pgs_block_t* _encoded_block,
-		pgs_block_t* _syndromes_table,
-		pgs_block_t* _polynome,
-		unsigned long long _input_block_size)
+		pgs_bch_t* _bch)
 {
-	pgs_block_t* syndrome;
-	pgb_copy(_decoded_block, 0, _encoded_block, 0, _input_block_size);
-	pgb_divmod2(&syndrome, _encoded_block, _polynome);
-	unsigned long long syndrome_ull = pgb_block_to_ull(syndrome);
-	if (likely(syndrome_ull > 0))
-		if (unlikely(_syndromes_table[syndrome_ull].used))
-			pgb_xor(_decoded_block, &_syndromes_table[syndrome_ull]);
-	pgb_destroy_block(syndrome);
+	uint64_t remainder[PGF_BCH_MAX_WORDS];
+	uint64_t errors = 0;
+	pgf_bch_remainder(_bch, _encoded_block, remainder);
+	for (unsigned long long i = 0; i < _bch->parity; i += PGS_UINT64_SIZE)
+	{
+		unsigned long long count = _bch->parity - i < PGS_UINT64_SIZE ? _bch->parity - i : PGS_UINT64_SIZE;
+		remainder[PGB_WORD(i)] ^= (uint64_t)pgb_get_bits(_encoded_block, _bch->k + i, count) << (PGS_UINT64_SIZE - count);
+		errors |= remainder[PGB_WORD(i)];
+	}
+	pgb_copy(_decoded_block, 0, _encoded_block, 0, _bch->k);
+	if (likely(errors == 0))
+		return;
+
+	unsigned int syndromes[2 * PGF_BCH_MAX_FEC_POWER + 1] = {0};
+	for (unsigned long long i = 0; i < _bch->words; i++)
+		for (uint64_t bits = remainder[i]; bits > 0; bits &= bits - 1)
+		{
+			unsigned long long position = i * PGS_UINT64_SIZE + PGS_UINT64_SIZE - 1 - __builtin_ctzll(bits);
+			unsigned long long exponent = _bch->parity - 1 - position;
+			for (unsigned long long j = 1; j < 2 * _bch->t; j += 2)
+				syndromes[j] ^= _bch->exp[exponent * j % _bch->n];
+		}
+	for (unsigned long long j = 2; j <= 2 * _bch->t; j += 2)
+		syndromes[j] = pgf_gf_mul(_bch, syndromes[j / 2], syndromes[j / 2]);
+
+	unsigned int locator[2 * PGF_BCH_MAX_FEC_POWER + 1] = {1};
+	unsigned int previous[2 * PGF_BCH_MAX_FEC_POWER + 1] = {1};
+	unsigned int saved[2 * PGF_BCH_MAX_FEC_POWER + 1];
+	unsigned long long degree = 0;
+	unsigned long long shift = 1;
+	unsigned int last = 1;
+	for (unsigned long long step = 0; step < 2 * _bch->t; step++)
+	{
+		unsigned int discrepancy = syndromes[step + 1];
+		for (unsigned long long i = 1; i <= degree; i++)
+			discrepancy ^= pgf_gf_mul(_bch, locator[i], syndromes[step + 1 - i]);
+		if (discrepancy == 0)
+		{
+			shift++;
+			continue;
+		}
+
+		unsigned int factor = pgf_gf_div(_bch, discrepancy, last);
+		unsigned int grow = 2 * degree <= step;
+		if (grow)
+			memcpy(saved, locator, sizeof(saved));
+		for (unsigned long long i = 0; i + shift <= 2 * _bch->t; i++)
+			locator[i + shift] ^= pgf_gf_mul(_bch, factor, previous[i]);
+		if (grow)
+		{
+			degree = step + 1 - degree;
+			memcpy(previous, saved, sizeof(previous));
+			last = discrepancy;
+			shift = 1;
+		} else
+			shift++;
+	}
+	if (unlikely(degree > _bch->t))
+		return;
+
+	unsigned long long terms[PGF_BCH_MAX_FEC_POWER];
+	unsigned long long powers[PGF_BCH_MAX_FEC_POWER];
+	unsigned long long active = 0;
+	for (unsigned long long i = 1; i <= degree; i++)
+		if (locator[i] != 0)
+		{
+			terms[active] = _bch->log[locator[i]];
+			powers[active] = i;
+			active++;
+		}
+
+	unsigned long long positions[PGF_BCH_MAX_FEC_POWER];
+	unsigned long long roots = 0;
+	for (unsigned long long i = 1; i <= _bch->n && roots < degree; i++)
+	{
+		unsigned int value = 1;
+		for (unsigned long long j = 0; j < active; j++)
+		{
+			terms[j] += powers[j];
+			if (terms[j] >= _bch->n)
+				terms[j] -= _bch->n;
+			value ^= _bch->exp[terms[j]];
+		}
+		if (unlikely(value == 0))
+			positions[roots++] = i - 1;
+	}
+	if (unlikely(roots != degree))
+		return;
+
+	for (unsigned long long i = 0; i < roots; i++)
+		if (positions[i] < _bch->k)
+			pgb_flip_bit(_decoded_block, positions[i]);
 }
 
 static void pgf_decode_block(pgs_block_t* _decoded_block,
@@ -391,29 +971,14 @@ static void pgf_decode_block(pgs_block_t* _decoded_block,
 		case PGF_NONE:
 			pgb_copy(_decoded_block, 0, _encoded_block, 0, _encoded_block->bits_count);
 			break;
-		case PGF_HAMMING74:
-			pgf_decode_block_hamming74(_decoded_block, _encoded_block);
-			break;
-		case PGF_CYCLIC85:
-			pgf_decode_block_crc(_decoded_block,
-					_encoded_block,
-					pgf_syndromes_cyclic85,
-					pgf_polynome_cyclic85,
-					PGF_CYCLIC85_INPUT_BLOCK_SIZE);
+		case PGF_BCH63457:
+			pgf_decode_block_bch(_decoded_block, _encoded_block, &pgf_bch63457);
 			break;
-		case PGF_BCH1557:
-			pgf_decode_block_crc(_decoded_block,
-					_encoded_block,
-					pgf_syndromes_bch1557,
-					pgf_polynome_bch1557,
-					PGF_BCH1557_INPUT_BLOCK_SIZE);
+		case PGF_BCH2552239:
+			pgf_decode_block_bch(_decoded_block, _encoded_block, &pgf_bch2552239);
 			break;
-		case PGF_BCH1575:
-			pgf_decode_block_crc(_decoded_block,
-					_encoded_block,
-					pgf_syndromes_bch1575,
-					pgf_polynome_bch1575,
-					PGF_BCH1575_INPUT_BLOCK_SIZE);
+		case PGF_BCH102392321:
+			pgf_decode_block_bch(_decoded_block, _encoded_block, &pgf_bch102392321);
 			break;
 		default:
 			pgp_switch_default();
@@ -424,19 +989,34 @@ static void pgf_decode_block(pgs_block_t* _decoded_block,
 unsigned long long pgf_decode_blocks(pgs_block_t** _decoded_blocks,
 		pgs_block_t* _encoded_blocks,
 		unsigned long long _encoded_blocks_count,
-		unsigned int _fec)
+		unsigned int _fec,
+		pgs_arena_t* _arena)
 {
 	if (unlikely(_encoded_blocks == NULL))
 		return 0;
 
-	*_decoded_blocks = pgb_create_blocks(_encoded_blocks_count, _fec == PGF_NONE ? _encoded_blocks[0].bits_count : pgf_get_input_block_size(_fec));
+	*_decoded_blocks = pgb_alloc_blocks(_arena, _encoded_blocks_count, _fec == PGF_NONE ? _encoded_blocks[0].bits_count : pgf_get_input_block_size(_fec));
 
+	pgs_sliced_code_t* sliced_code = pgf_get_sliced_code(_fec);
+	if (sliced_code != NULL)
+	{
 #if defined (_OPENMP)
 #pragma omp parallel for
 #endif
-	for (unsigned long long i = 0; i < _encoded_blocks_count; i++)
-		pgf_decode_block(&((pgs_block_t*)(*_decoded_blocks))[i],
-				&_encoded_blocks[i], _fec);
+		for (unsigned long long i = 0; i < _encoded_blocks_count; i += PGF_SLICE_CODEWORDS)
+			pgf_decode_slice(sliced_code,
+					&((pgs_block_t*)(*_decoded_blocks))[i],
+					&_encoded_blocks[i],
+					_encoded_blocks_count - i);
+	} else
+	{
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+		for (unsigned long long i = 0; i < _encoded_blocks_count; i++)
+			pgf_decode_block(&((pgs_block_t*)(*_decoded_blocks))[i],
+					&_encoded_blocks[i], _fec);
+	}
 
 	return _encoded_blocks_count;
 
@@ -31,20 +31,30 @@
 #define	PGF_CYCLIC85	3
 #define PGF_BCH1557	4
 #define PGF_BCH1575	5
+#define PGF_BCH63457	6
+#define PGF_BCH2552239	7
+#define PGF_BCH102392321	8
 
 #define PGF_NONE_STRING		"No FEC"
 #define PGF_HAMMING74_STRING	"Hamming code (7, 4)"
 #define PGF_CYCLIC85_STRING	"Cyclic code (8, 5)"
 #define PGF_BCH1557_STRING	"BCH code (15, 5, 7)"
 #define PGF_BCH1575_STRING	"BCH code (15, 7, 5)"
+#define PGF_BCH63457_STRING	"BCH code (63, 45, 7)"
+#define PGF_BCH2552239_STRING	"BCH code (255, 223, 9)"
+#define PGF_BCH102392321_STRING	"BCH code (1023, 923, 21)"
 
 #define PGF_CYCLIC85_POLYNOME	"1011"
 #define PGF_BCH1557_POLYNOME	"10100110111"
 #define PGF_BCH1575_POLYNOME	"111010001"
 
-#define PGF_CYCLIC85_TEST	"10101101"
-#define PGF_BCH1557_TEST	"101011001000111"
-#define PGF_BCH1575_TEST	"101010111100101"
+#define PGF_BCH63457_PRIMITIVE		0x43
+#define PGF_BCH2552239_PRIMITIVE	0x11d
+#define PGF_BCH102392321_PRIMITIVE	0x409
+
+#define PGF_BCH63457_FIELD_POWER	6
+#define PGF_BCH2552239_FIELD_POWER	8
+#define PGF_BCH102392321_FIELD_POWER	10
 
 #define PGF_NONE_INPUT_BLOCK_SIZE	0
 #define PGF_UNKNOWN_INPUT_BLOCK_SIZE	0
@@ -52,6 +62,9 @@
 #define PGF_CYCLIC85_INPUT_BLOCK_SIZE	5
 #define PGF_BCH1557_INPUT_BLOCK_SIZE	5
 #define PGF_BCH1575_INPUT_BLOCK_SIZE	7
+#define PGF_BCH63457_INPUT_BLOCK_SIZE	45
+#define PGF_BCH2552239_INPUT_BLOCK_SIZE	223
+#define PGF_BCH102392321_INPUT_BLOCK_SIZE	923
 
 #define PGF_NONE_OUTPUT_BLOCK_SIZE	0
 #define PGF_UNKNOWN_OUTPUT_BLOCK_SIZE	0
@@ -59,6 +72,9 @@
 #define PGF_CYCLIC85_OUTPUT_BLOCK_SIZE	8
 #define PGF_BCH1557_OUTPUT_BLOCK_SIZE	15
 #define PGF_BCH1575_OUTPUT_BLOCK_SIZE	15
+#define PGF_BCH63457_OUTPUT_BLOCK_SIZE	63
+#define PGF_BCH2552239_OUTPUT_BLOCK_SIZE	255
+#define PGF_BCH102392321_OUTPUT_BLOCK_SIZE	1023
 
 #define PGF_HAMMING74_FEC_SUFFIX	(PGF_HAMMING74_OUTPUT_BLOCK_SIZE - PGF_HAMMING74_INPUT_BLOCK_SIZE)
 #define PGF_CYCLIC85_FEC_SUFFIX		(PGF_CYCLIC85_OUTPUT_BLOCK_SIZE - PGF_CYCLIC85_INPUT_BLOCK_SIZE)
@@ -69,6 +85,14 @@
 #define PGF_CYCLIC85_FEC_POWER		1
 #define PGF_BCH1557_FEC_POWER		3
 #define PGF_BCH1575_FEC_POWER		2
+#define PGF_BCH63457_FEC_POWER		3
+#define PGF_BCH2552239_FEC_POWER	4
+#define PGF_BCH102392321_FEC_POWER	10
+
+#define PGF_BCH_MAX_FIELD_POWER	16
+#define PGF_BCH_MAX_FEC_POWER	32
+#define PGF_BCH_MAX_WORDS	((PGF_BCH_MAX_FIELD_POWER * PGF_BCH_MAX_FEC_POWER + PGS_UINT64_SIZE - 1) / PGS_UINT64_SIZE)
+#define PGF_SLICE_CODEWORDS	(PGS_UINT64_SIZE * PGS_SLICE_LANES)
 
 #define PGF_CYCLIC85_VOLUME	(1ULL << PGF_CYCLIC85_FEC_SUFFIX)
 #define PGF_BCH1557_VOLUME	(1ULL << PGF_BCH1557_FEC_SUFFIX)
@@ -87,12 +111,26 @@
 						{0, 2, 4, 6}, \
 					}
 
-pgs_block_t* pgf_syndromes_cyclic85;
-pgs_block_t* pgf_syndromes_bch1557;
-pgs_block_t* pgf_syndromes_bch1575;
+uint64_t* pgf_syndromes_cyclic85;
+uint64_t* pgf_syndromes_bch1557;
+uint64_t* pgf_syndromes_bch1575;
 pgs_block_t* pgf_polynome_cyclic85;
 pgs_block_t* pgf_polynome_bch1557;
 pgs_block_t* pgf_polynome_bch1575;
+pgs_remainders_t pgf_remainders_cyclic85;
+pgs_remainders_t pgf_remainders_bch1557;
+pgs_remainders_t pgf_remainders_bch1575;
+pgs_codebook_t pgf_codebook_hamming74;
+pgs_codebook_t pgf_codebook_cyclic85;
+pgs_codebook_t pgf_codebook_bch1557;
+pgs_codebook_t pgf_codebook_bch1575;
+pgs_bch_t pgf_bch63457;
+pgs_bch_t pgf_bch2552239;
+pgs_bch_t pgf_bch102392321;
+pgs_sliced_code_t pgf_sliced_hamming74;
+pgs_sliced_code_t pgf_sliced_cyclic85;
+pgs_sliced_code_t pgf_sliced_bch1557;
+pgs_sliced_code_t pgf_sliced_bch1575;
 
 void pgf_init_polynomes();
 void pgf_done_polynomes();
@@ -101,14 +139,22 @@ void pgf_done_syndromes();
 char* pgf_to_string(unsigned int _fec);
 unsigned long long pgf_get_input_block_size(unsigned int _fec);
 unsigned long long pgf_get_output_block_size(unsigned int _fec);
+unsigned int pgf_has_codebook(unsigned int _fec);
 unsigned long long pgf_encode_blocks(pgs_block_t** _encoded_blocks,
 		pgs_block_t* _source_blocks,
 		unsigned long long _source_blocks_count,
-		unsigned int _fec);
+		unsigned int _fec,
+		pgs_arena_t* _arena);
+unsigned long long pgf_encode_stream(pgs_block_t** _encoded_stream,
+		pgs_block_t* _source_stream,
+		unsigned long long _bits_count,
+		unsigned int _fec,
+		pgs_arena_t* _arena);
 unsigned long long pgf_decode_blocks(pgs_block_t** _decoded_blocks,
 		pgs_block_t* _encoded_blocks,
 		unsigned long long _encoded_blocks_count,
-		unsigned int _fec);
+		unsigned int _fec,
+		pgs_arena_t* _arena);
 
 #endif /* PEGASUS_FEC_H */
 
@@ -21,10 +21,14 @@
 
 #include <math.h>
 #include <stdlib.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 #include "pegasus_common_strings.h"
 #include "pegasus_common_types.h"
 
+#include "pegasus_arena.h"
 #include "pegasus_block.h"
 #include "pegasus_panic.h"
 #include "pegasus_tools.h"
@@ -108,6 +112,93 @@ static void pgm_fill_nonrectangle_qam(pgs_signal_t* _table,
 	}
 }
 
+static double pgm_cell_distance(double _point, double _start, double _end, unsigned int _farthest)
+{
+	if (_farthest == 1)
+		return fabs(_point - _start) > fabs(_point - _end) ? fabs(_point - _start) : fabs(_point - _end);
+	if (_point < _start)
+		return _start - _point;
+	if (_point > _end)
+		return _point - _end;
+	return 0.0;
+}
+
+static unsigned long long pgm_fill_cell(unsigned long long* _candidates,
+		pgs_grid_t* _grid,
+		unsigned long long _cell,
+		pgs_signal_t* _table,
+		unsigned long long _table_size)
+{
+	double i_start = _grid->origin + (double)(_cell % _grid->side) * _grid->step;
+	double q_start = _grid->origin + (double)(_cell / _grid->side) * _grid->step;
+	double i_end = i_start + _grid->step;
+	double q_end = q_start + _grid->step;
+	double bound = INFINITY;
+	unsigned long long ret = 0;
+
+	for (unsigned long long i = 0; i < _table_size; i++)
+	{
+		double di = pgm_cell_distance(_table[i].i, i_start, i_end, 1);
+		double dq = pgm_cell_distance(_table[i].q, q_start, q_end, 1);
+		if (di * di + dq * dq < bound)
+			bound = di * di + dq * dq;
+	}
+
+	for (unsigned long long i = 0; i < _table_size; i++)
+	{
+		double di = pgm_cell_distance(_table[i].i, i_start, i_end, 0);
+		double dq = pgm_cell_distance(_table[i].q, q_start, q_end, 0);
+		if (di * di + dq * dq <= bound)
+		{
+			if (_candidates != NULL && ret < PGM_GRID_CANDIDATES)
+				_candidates[ret] = i;
+			ret++;
+		}
+	}
+
+	return ret > PGM_GRID_CANDIDATES ? 0 : ret;
+}
+
+static void pgm_init_grid(pgs_grid_t* _grid,
+		pgs_signal_t* _table,
+		unsigned long long _table_size,
+		double _minimum)
+{
+	double extent = 0.0;
+	for (unsigned long long i = 0; i < _table_size; i++)
+	{
+		if (fabs(_table[i].i) > extent)
+			extent = fabs(_table[i].i);
+		if (fabs(_table[i].q) > extent)
+			extent = fabs(_table[i].q);
+	}
+	extent += PGM_GRID_MARGIN * _minimum;
+
+	_grid->step = _minimum;
+	_grid->side = (unsigned long long)ceil(2.0 * extent / _grid->step);
+	_grid->origin = -0.5 * (double)_grid->side * _grid->step;
+
+	unsigned long long cells_count = _grid->side * _grid->side;
+	_grid->offsets = pgt_alloc(cells_count + 1, sizeof(unsigned long long));
+
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < cells_count; i++)
+		_grid->offsets[i + 1] = pgm_fill_cell(NULL, _grid, i, _table, _table_size);
+
+	for (unsigned long long i = 0; i < cells_count; i++)
+		_grid->offsets[i + 1] += _grid->offsets[i];
+
+	_grid->candidates = pgt_alloc(_grid->offsets[cells_count], sizeof(unsigned long long));
+
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < cells_count; i++)
+		pgm_fill_cell(&_grid->candidates[_grid->offsets[i]], _grid, i, _table, _table_size);
+}
+
 void pgm_init_tables()
 {
 #if defined (_OPENMP)
@@ -217,6 +308,14 @@ void pgm_init_tables()
 			pgm_fill_rectangle_qam(pgm_4096qam_table, PGM_4096QAM_NORMALIZATION, PGM_4096QAM_BOUND);
 		}
 	}
+
+	pgm_init_grid(&pgm_32qam_grid, pgm_32qam_table, PGM_32QAM_VOLUME, PGM_32QAM_MINIMUM);
+}
+
+void pgm_done_tables()
+{
+	free(pgm_32qam_grid.offsets);
+	free(pgm_32qam_grid.candidates);
 }
 
 char* pgm_to_string(unsigned int _modulation)
@@ -405,86 +504,128 @@ unsigned long long pgm_get_block_size(unsigned int _modulation)
 	}
 }
 
-static void pgm_modulate_block(pgs_signal_t* _signal, pgs_block_t* _block, unsigned int _modulation)
+static pgs_signal_t* pgm_get_table(unsigned int _modulation)
 {
-	pgs_signal_t* current_signal = NULL;
 	switch (_modulation)
 	{
 		case PGM_ASK:
-			current_signal = &pgm_ask_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_ask_table;
 		case PGM_FSK:
-			current_signal = &pgm_fsk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_fsk_table;
 		case PGM_BPSK:
-			current_signal = &pgm_bpsk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_bpsk_table;
 		case PGM_QPSK:
-			current_signal = &pgm_qpsk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_qpsk_table;
 		case PGM_8PSK:
-			current_signal = &pgm_8psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_8psk_table;
 		case PGM_16PSK:
-			current_signal = &pgm_16psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_16psk_table;
 		case PGM_32PSK:
-			current_signal = &pgm_32psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_32psk_table;
 		case PGM_64PSK:
-			current_signal = &pgm_64psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_64psk_table;
 		case PGM_256PSK:
-			current_signal = &pgm_256psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_256psk_table;
 		case PGM_1024PSK:
-			current_signal = &pgm_1024psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_1024psk_table;
 		case PGM_4096PSK:
-			current_signal = &pgm_4096psk_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_4096psk_table;
 		case PGM_16QAM:
-			current_signal = &pgm_16qam_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_16qam_table;
 		case PGM_32QAM:
-			current_signal = &pgm_32qam_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_32qam_table;
 		case PGM_64QAM:
-			current_signal = &pgm_64qam_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_64qam_table;
 		case PGM_256QAM:
-			current_signal = &pgm_256qam_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_256qam_table;
 		case PGM_1024QAM:
-			current_signal = &pgm_1024qam_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_1024qam_table;
 		case PGM_4096QAM:
-			current_signal = &pgm_4096qam_table[pgb_block_to_ull(_block)];
-			break;
+			return pgm_4096qam_table;
 		default:
 			pgp_switch_default();
 			break;
 	}
-	_signal->i = current_signal->i;
-	_signal->q = current_signal->q;
+
+	return NULL;
 }
 
+unsigned long long pgm_modulate_soa(pgs_signals_t* _modulated_signals,
+		pgs_block_t* _premodulated_blocks,
+		unsigned long long _premodulated_blocks_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena)
+{
+	if (unlikely(_premodulated_blocks == NULL))
+		return 0;
+
+	pgs_signal_t* table = pgm_get_table(_modulation);
+	*_modulated_signals = pga_alloc_signals(_arena, _premodulated_blocks_count);
+	double* modulated_i = _modulated_signals->i;
+	double* modulated_q = _modulated_signals->q;
 
-unsigned long long pgm_modulate(pgs_signal_t** _modulated_signals,
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < _premodulated_blocks_count; i++)
+	{
+		pgs_signal_t* current_signal = &table[pgb_block_to_ull(&_premodulated_blocks[i])];
+		modulated_i[i] = current_signal->i;
+		modulated_q[i] = current_signal->q;
+	}
+
+	return _premodulated_blocks_count;
+}
+
+unsigned long long pgm_modulate_soa_f(pgs_signals_f_t* _modulated_signals,
 		pgs_block_t* _premodulated_blocks,
 		unsigned long long _premodulated_blocks_count,
-		unsigned int _modulation)
+		unsigned int _modulation,
+		pgs_arena_t* _arena)
 {
 	if (unlikely(_premodulated_blocks == NULL))
 		return 0;
 
-	*_modulated_signals = pgt_alloc(_premodulated_blocks_count, sizeof(pgs_signal_t));
+	pgs_signal_t* table = pgm_get_table(_modulation);
+	*_modulated_signals = pga_alloc_signals_f(_arena, _premodulated_blocks_count);
+	float* modulated_i = _modulated_signals->i;
+	float* modulated_q = _modulated_signals->q;
 
 #if defined (_OPENMP)
 #pragma omp parallel for
 #endif
 	for (unsigned long long i = 0; i < _premodulated_blocks_count; i++)
-		pgm_modulate_block(&((pgs_signal_t*)(*_modulated_signals))[i], &_premodulated_blocks[i], _modulation);
+	{
+		pgs_signal_t* current_signal = &table[pgb_block_to_ull(&_premodulated_blocks[i])];
+		modulated_i[i] = (float)current_signal->i;
+		modulated_q[i] = (float)current_signal->q;
+	}
+
+	return _premodulated_blocks_count;
+}
+
+unsigned long long pgm_modulate(pgs_signal_t** _modulated_signals,
+		pgs_block_t* _premodulated_blocks,
+		unsigned long long _premodulated_blocks_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena)
+{
+	pgs_signals_t modulated_signals;
+
+	if (unlikely(pgm_modulate_soa(&modulated_signals,
+				_premodulated_blocks,
+				_premodulated_blocks_count,
+				_modulation,
+				_arena) == 0))
+		return 0;
+
+	*_modulated_signals = pga_alloc(_arena, _premodulated_blocks_count, sizeof(pgs_signal_t));
+
+	for (unsigned long long i = 0; i < _premodulated_blocks_count; i++)
+	{
+		(*_modulated_signals)[i].i = modulated_signals.i[i];
+		(*_modulated_signals)[i].q = modulated_signals.q[i];
+	}
 
 	return _premodulated_blocks_count;
 }
@@ -515,145 +656,306 @@ static void pgm_find_block(pgs_block_t* _block,
 	pgb_ull_to_block(_block, min_index);
 }
 
-static void pgm_demodulate_block(pgs_block_t* _demodulated_block, pgs_signal_t* _modulated_signal, unsigned int _modulation)
+static void pgm_find_blocks(pgs_block_t* _blocks,
+		double* _real_i,
+		double* _real_q,
+		unsigned long long _count,
+		pgs_signal_t* _table,
+		unsigned long long _table_size)
+{
+	unsigned long long i = 0;
+
+#if defined(__AVX512F__)
+	for (; i + 8 <= _count; i += 8)
+	{
+		double indices[8];
+		__m512d real_i = _mm512_loadu_pd(&_real_i[i]);
+		__m512d real_q = _mm512_loadu_pd(&_real_q[i]);
+		__m512d min_distance = _mm512_set1_pd(INFINITY);
+		__m512d min_index = _mm512_setzero_pd();
+		for (unsigned long long j = 0; j < _table_size; j++)
+		{
+			__m512d di = _mm512_sub_pd(real_i, _mm512_set1_pd(_table[j].i));
+			__m512d dq = _mm512_sub_pd(real_q, _mm512_set1_pd(_table[j].q));
+			__m512d distance = _mm512_fmadd_pd(di, di, _mm512_mul_pd(dq, dq));
+			__mmask8 closer = _mm512_cmp_pd_mask(distance, min_distance, _CMP_LT_OQ);
+			min_distance = _mm512_mask_blend_pd(closer, min_distance, distance);
+			min_index = _mm512_mask_blend_pd(closer, min_index, _mm512_set1_pd((double)j));
+		}
+		_mm512_storeu_pd(indices, min_index);
+		for (unsigned long long k = 0; k < 8; k++)
+			pgb_ull_to_block(&_blocks[i + k], (unsigned long long)indices[k]);
+	}
+#elif defined(__AVX2__)
+	for (; i + 4 <= _count; i += 4)
+	{
+		double indices[4];
+		__m256d real_i = _mm256_loadu_pd(&_real_i[i]);
+		__m256d real_q = _mm256_loadu_pd(&_real_q[i]);
+		__m256d min_distance = _mm256_set1_pd(INFINITY);
+		__m256d min_index = _mm256_setzero_pd();
+		for (unsigned long long j = 0; j < _table_size; j++)
+		{
+			__m256d di = _mm256_sub_pd(real_i, _mm256_set1_pd(_table[j].i));
+			__m256d dq = _mm256_sub_pd(real_q, _mm256_set1_pd(_table[j].q));
+			__m256d distance = _mm256_add_pd(_mm256_mul_pd(di, di), _mm256_mul_pd(dq, dq));
+			__m256d closer = _mm256_cmp_pd(distance, min_distance, _CMP_LT_OQ);
+			min_distance = _mm256_blendv_pd(min_distance, distance, closer);
+			min_index = _mm256_blendv_pd(min_index, _mm256_set1_pd((double)j), closer);
+		}
+		_mm256_storeu_pd(indices, min_index);
+		for (unsigned long long k = 0; k < 4; k++)
+			pgb_ull_to_block(&_blocks[i + k], (unsigned long long)indices[k]);
+	}
+#endif
+
+	for (; i < _count; i++)
+	{
+		unsigned long long min_index = 0;
+		double min_distance = INFINITY;
+		for (unsigned long long j = 0; j < _table_size; j++)
+		{
+			double di = _real_i[i] - _table[j].i;
+			double dq = _real_q[i] - _table[j].q;
+			double distance = di * di + dq * dq;
+			if (distance < min_distance)
+			{
+				min_index = j;
+				min_distance = distance;
+			}
+		}
+		pgb_ull_to_block(&_blocks[i], min_index);
+	}
+}
+
+static void pgm_find_block_in_grid(pgs_block_t* _block,
+		double _real_i,
+		double _real_q,
+		pgs_signal_t* _table,
+		unsigned long long _table_size,
+		double _minimum,
+		pgs_grid_t* _grid)
+{
+	double column = floor((_real_i - _grid->origin) / _grid->step);
+	double row = floor((_real_q - _grid->origin) / _grid->step);
+
+	if (unlikely(column < 0.0 || row < 0.0 || column >= (double)_grid->side || row >= (double)_grid->side))
+	{
+		pgm_find_block(_block, _real_i, _real_q, _table, _table_size, _minimum);
+		return;
+	}
+
+	unsigned long long cell = (unsigned long long)row * _grid->side + (unsigned long long)column;
+	unsigned long long start = _grid->offsets[cell];
+	unsigned long long end = _grid->offsets[cell + 1];
+
+	if (unlikely(start == end))
+	{
+		pgm_find_block(_block, _real_i, _real_q, _table, _table_size, _minimum);
+		return;
+	}
+
+	unsigned long long min_index = _grid->candidates[start];
+	double min_distance = (_real_i - _table[min_index].i) * (_real_i - _table[min_index].i) +
+		(_real_q - _table[min_index].q) * (_real_q - _table[min_index].q);
+	for (unsigned long long i = start + 1; i < end; i++)
+	{
+		unsigned long long index = _grid->candidates[i];
+		double current_distance = (_real_i - _table[index].i) * (_real_i - _table[index].i) +
+			(_real_q - _table[index].q) * (_real_q - _table[index].q);
+		if (current_distance < min_distance)
+		{
+			min_index = index;
+			min_distance = current_distance;
+		}
+	}
+	pgb_ull_to_block(_block, min_index);
+}
+
+static inline unsigned long long pgm_slice_axis(double _value,
+		double _normalization_factor,
+		long long _bound)
+{
+	double level = floor((_value / _normalization_factor + (double)_bound) / 2.0 + 0.5);
+
+	if (unlikely(level < 0.0))
+		return 0;
+	if (unlikely(level > (double)_bound))
+		return _bound;
+	return (unsigned long long)level;
+}
+
+static void pgm_slice_rectangle_qam(pgs_block_t* _block,
+		double _real_i,
+		double _real_q,
+		double _normalization_factor,
+		long long _bound)
+{
+	unsigned long long side = _bound + 1;
+	unsigned long long column = pgm_slice_axis(_real_i, _normalization_factor, _bound);
+	unsigned long long row = pgm_slice_axis(_real_q, _normalization_factor, _bound);
+	unsigned long long index = column * side + ((column & 1) == 0 ? row : side - 1 - row);
+
+	pgb_ull_to_block(_block, pgt_value_to_gray(index));
+}
+
+static inline double pgm_fast_atan2(double _y, double _x)
+{
+	double abs_x = fabs(_x);
+	double abs_y = fabs(_y);
+	double maximum = abs_x > abs_y ? abs_x : abs_y;
+	double minimum = abs_x > abs_y ? abs_y : abs_x;
+	double ratio = maximum > 0.0 ? minimum / maximum : 0.0;
+	double ratio_square = ratio * ratio;
+	double ret = ratio * (0.9998660 + ratio_square * (-0.3302995 + ratio_square *
+			(0.1801410 + ratio_square * (-0.0851330 + ratio_square * 0.0208351))));
+
+	ret = abs_y > abs_x ? M_PI_2 - ret : ret;
+	ret = _x < 0.0 ? M_PI - ret : ret;
+	return _y < 0.0 ? -ret : ret;
+}
+
+static void pgm_slice_psk(pgs_block_t* _block,
+		double _real_i,
+		double _real_q,
+		pgs_signal_t* _table,
+		unsigned long long _volume,
+		double _angle_step,
+		double _phase_shift)
+{
+	double sector = (pgm_fast_atan2(_real_q, _real_i) - _phase_shift) / (2.0 * _angle_step);
+	double lower = floor(sector);
+	double fraction = sector - lower;
+	unsigned long long index = (unsigned long long)((long long)lower + (long long)_volume) % _volume;
+	unsigned long long next = (index + 1) % _volume;
+
+	if (unlikely(fabs(fraction - 0.5) < PGM_ATAN2_TOLERANCE / (2.0 * _angle_step)))
+	{
+		pgs_signal_t* lower_signal = &_table[pgt_value_to_gray(index)];
+		pgs_signal_t* next_signal = &_table[pgt_value_to_gray(next)];
+		double lower_distance = (_real_i - lower_signal->i) * (_real_i - lower_signal->i) +
+			(_real_q - lower_signal->q) * (_real_q - lower_signal->q);
+		double next_distance = (_real_i - next_signal->i) * (_real_i - next_signal->i) +
+			(_real_q - next_signal->q) * (_real_q - next_signal->q);
+		if (next_distance < lower_distance)
+			index = next;
+	}
+	else if (fraction > 0.5)
+		index = next;
+
+	pgb_ull_to_block(_block, pgt_value_to_gray(index));
+}
+
+static void pgm_demodulate_block(pgs_block_t* _demodulated_block, double _real_i, double _real_q, unsigned int _modulation)
 {
 	switch (_modulation)
 	{
-		case PGM_ASK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_ask_table,
-					PGM_ASK_VOLUME,
-					PGM_ASK_MINIMUM);
-			break;
-		case PGM_FSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_fsk_table,
-					PGM_FSK_VOLUME,
-					PGM_FSK_MINIMUM);
-			break;
-		case PGM_BPSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_bpsk_table,
-					PGM_BPSK_VOLUME,
-					PGM_BPSK_MINIMUM);
-			break;
-		case PGM_QPSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_qpsk_table,
-					PGM_QPSK_VOLUME,
-					PGM_QPSK_MINIMUM);
-			break;
 		case PGM_8PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_8psk_table,
 					PGM_8PSK_VOLUME,
-					PGM_8PSK_MINIMUM);
+					PGM_8PSK_ANGLE_STEP,
+					PGM_8PSK_PHASE_SHIFT);
 			break;
 		case PGM_16PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_16psk_table,
 					PGM_16PSK_VOLUME,
-					PGM_16PSK_MINIMUM);
+					PGM_16PSK_ANGLE_STEP,
+					PGM_16PSK_PHASE_SHIFT);
 			break;
 		case PGM_32PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_32psk_table,
 					PGM_32PSK_VOLUME,
-					PGM_32PSK_MINIMUM);
+					PGM_32PSK_ANGLE_STEP,
+					PGM_32PSK_PHASE_SHIFT);
 			break;
 		case PGM_64PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_64psk_table,
 					PGM_64PSK_VOLUME,
-					PGM_64PSK_MINIMUM);
+					PGM_64PSK_ANGLE_STEP,
+					PGM_64PSK_PHASE_SHIFT);
 			break;
 		case PGM_256PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_256psk_table,
 					PGM_256PSK_VOLUME,
-					PGM_256PSK_MINIMUM);
+					PGM_256PSK_ANGLE_STEP,
+					PGM_256PSK_PHASE_SHIFT);
 			break;
 		case PGM_1024PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_1024psk_table,
 					PGM_1024PSK_VOLUME,
-					PGM_1024PSK_MINIMUM);
+					PGM_1024PSK_ANGLE_STEP,
+					PGM_1024PSK_PHASE_SHIFT);
 			break;
 		case PGM_4096PSK:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_slice_psk(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_4096psk_table,
 					PGM_4096PSK_VOLUME,
-					PGM_4096PSK_MINIMUM);
+					PGM_4096PSK_ANGLE_STEP,
+					PGM_4096PSK_PHASE_SHIFT);
 			break;
 		case PGM_16QAM:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_16qam_table,
-					PGM_16QAM_VOLUME,
-					PGM_16QAM_MINIMUM);
+			pgm_slice_rectangle_qam(_demodulated_block,
+					_real_i,
+					_real_q,
+					PGM_16QAM_NORMALIZATION,
+					PGM_16QAM_BOUND);
 			break;
 		case PGM_32QAM:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
+			pgm_find_block_in_grid(_demodulated_block,
+					_real_i,
+					_real_q,
 					pgm_32qam_table,
 					PGM_32QAM_VOLUME,
-					PGM_32QAM_MINIMUM);
+					PGM_32QAM_MINIMUM,
+					&pgm_32qam_grid);
 			break;
 		case PGM_64QAM:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_64qam_table,
-					PGM_64QAM_VOLUME,
-					PGM_64QAM_MINIMUM);
+			pgm_slice_rectangle_qam(_demodulated_block,
+					_real_i,
+					_real_q,
+					PGM_64QAM_NORMALIZATION,
+					PGM_64QAM_BOUND);
 			break;
 		case PGM_256QAM:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_256qam_table,
-					PGM_256QAM_VOLUME,
-					PGM_256QAM_MINIMUM);
+			pgm_slice_rectangle_qam(_demodulated_block,
+					_real_i,
+					_real_q,
+					PGM_256QAM_NORMALIZATION,
+					PGM_256QAM_BOUND);
 			break;
 		case PGM_1024QAM:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_1024qam_table,
-					PGM_1024QAM_VOLUME,
-					PGM_1024QAM_MINIMUM);
+			pgm_slice_rectangle_qam(_demodulated_block,
+					_real_i,
+					_real_q,
+					PGM_1024QAM_NORMALIZATION,
+					PGM_1024QAM_BOUND);
 			break;
 		case PGM_4096QAM:
-			pgm_find_block(_demodulated_block,
-					_modulated_signal->i,
-					_modulated_signal->q,
-					pgm_4096qam_table,
-					PGM_4096QAM_VOLUME,
-					PGM_4096QAM_MINIMUM);
+			pgm_slice_rectangle_qam(_demodulated_block,
+					_real_i,
+					_real_q,
+					PGM_4096QAM_NORMALIZATION,
+					PGM_4096QAM_BOUND);
 			break;
 		default:
 			pgp_switch_default();
@@ -661,22 +963,280 @@ static void pgm_demodulate_block(pgs_block_t* _demodulated_block, pgs_signal_t*
 	}
 }
 
+unsigned long long pgm_demodulate_soa(pgs_block_t** _demodulated_blocks,
+		pgs_signals_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena)
+{
+	if (unlikely(_modulated_signals == NULL || _modulated_signals->i == NULL || _modulated_signals->q == NULL))
+		return 0;
+
+	*_demodulated_blocks = pgb_alloc_blocks(_arena, _modulated_signals_count, pgm_get_block_size(_modulation));
+
+	pgs_signal_t* table = NULL;
+	switch (_modulation)
+	{
+		case PGM_ASK:
+			table = pgm_ask_table;
+			break;
+		case PGM_FSK:
+			table = pgm_fsk_table;
+			break;
+		case PGM_BPSK:
+			table = pgm_bpsk_table;
+			break;
+		case PGM_QPSK:
+			table = pgm_qpsk_table;
+			break;
+		default:
+			break;
+	}
+
+	if (table != NULL)
+	{
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+		for (unsigned long long i = 0; i < _modulated_signals_count; i += PGM_BATCH_SIZE)
+			pgm_find_blocks(&((pgs_block_t*)(*_demodulated_blocks))[i],
+					&_modulated_signals->i[i],
+					&_modulated_signals->q[i],
+					_modulated_signals_count - i < PGM_BATCH_SIZE ? _modulated_signals_count - i : PGM_BATCH_SIZE,
+					table,
+					pgm_get_volume(_modulation));
+		return _modulated_signals_count;
+	}
+
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+		pgm_demodulate_block(&((pgs_block_t*)(*_demodulated_blocks))[i],
+				_modulated_signals->i[i],
+				_modulated_signals->q[i],
+				_modulation);
+
+	return _modulated_signals_count;
+}
+
+unsigned long long pgm_demodulate_soa_f(pgs_block_t** _demodulated_blocks,
+		pgs_signals_f_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena)
+{
+	if (unlikely(_modulated_signals == NULL || _modulated_signals->i == NULL || _modulated_signals->q == NULL))
+		return 0;
+
+	pgs_signals_t modulated_signals = pga_alloc_signals(_arena, _modulated_signals_count);
+
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+	{
+		modulated_signals.i[i] = (double)_modulated_signals->i[i];
+		modulated_signals.q[i] = (double)_modulated_signals->q[i];
+	}
+
+	return pgm_demodulate_soa(_demodulated_blocks,
+			&modulated_signals,
+			_modulated_signals_count,
+			_modulation,
+			_arena);
+}
+
 unsigned long long pgm_demodulate(pgs_block_t** _demodulated_blocks,
 		pgs_signal_t* _modulated_signals,
 		unsigned long long _modulated_signals_count,
-		unsigned int _modulation)
+		unsigned int _modulation,
+		pgs_arena_t* _arena)
 {
 	if (unlikely(_modulated_signals == NULL))
 		return 0;
 
-	*_demodulated_blocks = pgb_create_blocks(_modulated_signals_count, pgm_get_block_size(_modulation));
+	pgs_signals_t modulated_signals = pga_alloc_signals(_arena, _modulated_signals_count);
+
+	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+	{
+		modulated_signals.i[i] = _modulated_signals[i].i;
+		modulated_signals.q[i] = _modulated_signals[i].q;
+	}
+
+	return pgm_demodulate_soa(_demodulated_blocks,
+			&modulated_signals,
+			_modulated_signals_count,
+			_modulation,
+			_arena);
+}
+
+static inline double pgm_jacobian_log(double _a, double _b)
+{
+	return (_a > _b ? _a : _b) + log1p(exp(-fabs(_a - _b)));
+}
+
+static void pgm_demodulate_llr_signals(float* _llrs,
+		const double* _modulated_i,
+		const double* _modulated_q,
+		const double* _scales,
+		unsigned long long _count,
+		pgs_signal_t* _table,
+		unsigned long long _table_size,
+		unsigned long long _block_size,
+		unsigned int _method)
+{
+	double modulated_i[PGM_LLR_BATCH_SIZE] = {0};
+	double modulated_q[PGM_LLR_BATCH_SIZE] = {0};
+	double scales[PGM_LLR_BATCH_SIZE] = {0};
+	double metrics[PGM_LLR_BATCH_SIZE];
+	double sums[PGM_MAX_BLOCK_SIZE][2][PGM_LLR_BATCH_SIZE];
+
+	for (unsigned long long s = 0; s < _count; s++)
+	{
+		modulated_i[s] = _modulated_i[s];
+		modulated_q[s] = _modulated_q[s];
+		scales[s] = _scales[s];
+	}
+
+	for (unsigned long long j = 0; j < _table_size; j++)
+	{
+		double table_i = _table[j].i;
+		double table_q = _table[j].q;
+#if defined (_OPENMP)
+#pragma omp simd
+#endif
+		for (unsigned long long s = 0; s < PGM_LLR_BATCH_SIZE; s++)
+		{
+			double di = modulated_i[s] - table_i;
+			double dq = modulated_q[s] - table_q;
+			metrics[s] = -scales[s] * (di * di + dq * dq);
+		}
+
+		for (unsigned long long k = 0; k < _block_size; k++)
+		{
+			unsigned long long mask = 1ULL << (_block_size - 1 - k);
+			unsigned int bit = (j & mask) != 0;
+			double* sum = sums[k][bit];
+
+			if (j == (bit ? mask : 0))
+			{
+				for (unsigned long long s = 0; s < PGM_LLR_BATCH_SIZE; s++)
+					sum[s] = metrics[s];
+				continue;
+			}
+
+			switch (_method)
+			{
+				case PGM_LLR_MAX_LOG:
+#if defined (_OPENMP)
+#pragma omp simd
+#endif
+					for (unsigned long long s = 0; s < PGM_LLR_BATCH_SIZE; s++)
+						sum[s] = metrics[s] > sum[s] ? metrics[s] : sum[s];
+					break;
+				case PGM_LLR_LOG_MAP:
+#if defined (_OPENMP)
+#pragma omp simd
+#endif
+					for (unsigned long long s = 0; s < PGM_LLR_BATCH_SIZE; s++)
+						sum[s] = pgm_jacobian_log(sum[s], metrics[s]);
+					break;
+				default:
+					pgp_switch_default();
+					break;
+			}
+		}
+	}
+
+	for (unsigned long long s = 0; s < _count; s++)
+		for (unsigned long long k = 0; k < _block_size; k++)
+			_llrs[s * _block_size + k] = (float)(sums[k][0][s] - sums[k][1][s]);
+}
+
+unsigned long long pgm_demodulate_llr_soa(float** _llrs,
+		pgs_signals_t* _modulated_signals,
+		pgs_signals_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		unsigned int _method,
+		double _hsquare,
+		pgs_arena_t* _arena)
+{
+	if (unlikely(_modulated_signals == NULL || _modulated_signals->i == NULL || _modulated_signals->q == NULL))
+		return 0;
+
+	pgs_signal_t* table = pgm_get_table(_modulation);
+	unsigned long long table_size = pgm_get_volume(_modulation);
+	unsigned long long block_size = pgm_get_block_size(_modulation);
+	const double* fading_i = _fading == NULL ? NULL : _fading->i;
+	const double* fading_q = _fading == NULL ? NULL : _fading->q;
+	float* llrs = pga_alloc(_arena, _modulated_signals_count * block_size, sizeof(float));
+	double* scales = pga_alloc(_arena, _modulated_signals_count, sizeof(double));
 
 #if defined (_OPENMP)
 #pragma omp parallel for
 #endif
 	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
-		pgm_demodulate_block(&((pgs_block_t*)(*_demodulated_blocks))[i], &_modulated_signals[i], _modulation);
+		scales[i] = fading_i == NULL ? _hsquare :
+			_hsquare * (fading_i[i] * fading_i[i] + fading_q[i] * fading_q[i]);
 
-	return _modulated_signals_count;
+#if defined (_OPENMP)
+#pragma omp parallel for
+#endif
+	for (unsigned long long i = 0; i < _modulated_signals_count; i += PGM_LLR_BATCH_SIZE)
+		pgm_demodulate_llr_signals(&llrs[i * block_size],
+				&_modulated_signals->i[i],
+				&_modulated_signals->q[i],
+				&scales[i],
+				_modulated_signals_count - i < PGM_LLR_BATCH_SIZE ? _modulated_signals_count - i : PGM_LLR_BATCH_SIZE,
+				table,
+				table_size,
+				block_size,
+				_method);
+
+	*_llrs = llrs;
+
+	return _modulated_signals_count * block_size;
 }
 
+unsigned long long pgm_demodulate_llr(float** _llrs,
+		pgs_signal_t* _modulated_signals,
+		pgs_signal_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		unsigned int _method,
+		double _hsquare,
+		pgs_arena_t* _arena)
+{
+	if (unlikely(_modulated_signals == NULL))
+		return 0;
+
+	pgs_signals_t modulated_signals = pga_alloc_signals(_arena, _modulated_signals_count);
+	pgs_signals_t fading = {NULL, NULL};
+
+	for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+	{
+		modulated_signals.i[i] = _modulated_signals[i].i;
+		modulated_signals.q[i] = _modulated_signals[i].q;
+	}
+
+	if (_fading != NULL)
+	{
+		fading = pga_alloc_signals(_arena, _modulated_signals_count);
+		for (unsigned long long i = 0; i < _modulated_signals_count; i++)
+		{
+			fading.i[i] = _fading[i].i;
+			fading.q[i] = _fading[i].q;
+		}
+	}
+
+	return pgm_demodulate_llr_soa(_llrs,
+			&modulated_signals,
+			&fading,
+			_modulated_signals_count,
+			_modulation,
+			_method,
+			_hsquare,
+			_arena);
+}
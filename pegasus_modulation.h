@@ -42,6 +42,9 @@
 #define PGM_1024QAM	16
 #define PGM_4096QAM	17
 
+#define PGM_LLR_MAX_LOG	1
+#define PGM_LLR_LOG_MAP	2
+
 #define PGM_ASK_STRING		"Amplitude-shift keying"
 #define PGM_FSK_STRING		"Frequency-shift keying"
 #define PGM_BPSK_STRING		"Binary phase-shift keying"
@@ -98,6 +101,9 @@
 #define PGM_1024QAM_VOLUME	(1ULL << PGM_1024QAM_BLOCK_SIZE)
 #define PGM_4096QAM_VOLUME	(1ULL << PGM_4096QAM_BLOCK_SIZE)
 
+#define PGM_MAX_VOLUME		PGM_4096QAM_VOLUME
+#define PGM_MAX_BLOCK_SIZE	PGM_4096QAM_BLOCK_SIZE
+
 #define PGM_ASK_ANGLE_STEP	0
 #define PGM_FSK_ANGLE_STEP	(M_PI / 4.0)
 #define PGM_BPSK_ANGLE_STEP	(M_PI / 2.0)
@@ -122,6 +128,14 @@
 #define PGM_1024PSK_PHASE_SHIFT	0
 #define PGM_4096PSK_PHASE_SHIFT	0
 
+#define PGM_ATAN2_TOLERANCE	2e-5
+
+#define PGM_BATCH_SIZE		256
+#define PGM_LLR_BATCH_SIZE	8
+
+#define PGM_GRID_MARGIN		4
+#define PGM_GRID_CANDIDATES	8
+
 #define PGM_16QAM_BOUND		3
 #define PGM_32QAM_BOUND		5
 #define PGM_64QAM_BOUND		7
@@ -172,18 +186,59 @@ pgs_signal_t pgm_256qam_table[PGM_256QAM_VOLUME];
 pgs_signal_t pgm_1024qam_table[PGM_1024QAM_VOLUME];
 pgs_signal_t pgm_4096qam_table[PGM_4096QAM_VOLUME];
 
+pgs_grid_t pgm_32qam_grid;
+
 void pgm_init_tables();
+void pgm_done_tables();
 char* pgm_to_string(unsigned int _modulation);
 unsigned long long pgm_get_block_size(unsigned int _modulation);
 unsigned long long pgm_get_volume(unsigned int _modulation);
+unsigned long long pgm_modulate_soa(pgs_signals_t* _modulated_signals,
+		pgs_block_t* _premodulated_blocks,
+		unsigned long long _premodulated_blocks_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena);
+unsigned long long pgm_modulate_soa_f(pgs_signals_f_t* _modulated_signals,
+		pgs_block_t* _premodulated_blocks,
+		unsigned long long _premodulated_blocks_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena);
 unsigned long long pgm_modulate(pgs_signal_t** _modulated_signals,
 		pgs_block_t* _premodulated_blocks,
 		unsigned long long _premodulated_blocks_count,
-		unsigned int _modulation);
+		unsigned int _modulation,
+		pgs_arena_t* _arena);
+unsigned long long pgm_demodulate_soa(pgs_block_t** _demodulated_blocks,
+		pgs_signals_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena);
+unsigned long long pgm_demodulate_soa_f(pgs_block_t** _demodulated_blocks,
+		pgs_signals_f_t* _modulated_signals,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		pgs_arena_t* _arena);
 unsigned long long pgm_demodulate(pgs_block_t** _demodulated_blocks,
 		pgs_signal_t* _modulated_signals,
 		unsigned long long _modulated_signals_count,
-		unsigned int _modulation);
+		unsigned int _modulation,
+		pgs_arena_t* _arena);
+unsigned long long pgm_demodulate_llr_soa(float** _llrs,
+		pgs_signals_t* _modulated_signals,
+		pgs_signals_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		unsigned int _method,
+		double _hsquare,
+		pgs_arena_t* _arena);
+unsigned long long pgm_demodulate_llr(float** _llrs,
+		pgs_signal_t* _modulated_signals,
+		pgs_signal_t* _fading,
+		unsigned long long _modulated_signals_count,
+		unsigned int _modulation,
+		unsigned int _method,
+		double _hsquare,
+		pgs_arena_t* _arena);
 
 #endif /* PEGASUS_MODULATION_H */
 
@@ -0,0 +1,451 @@
+/**
+ * @author Oleksandr Natalenko aka post-factum <oleksandr@natalenko.name>
+ *
+ * @section LICENSE
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * pegasus — digital channel simulator, pipeline file
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "pegasus_common_strings.h"
+#include "pegasus_common_types.h"
+
+#include "pegasus_arena.h"
+#include "pegasus_channel.h"
+#include "pegasus_error.h"
+#include "pegasus_fec.h"
+#include "pegasus_modulation.h"
+#include "pegasus_panic.h"
+#include "pegasus_random.h"
+#include "pegasus_source.h"
+#include "pegasus_tools.h"
+
+#include "pegasus_pipeline.h"
+
+char* pgl_precision_to_string(unsigned int _precision)
+{
+	switch (_precision)
+	{
+		case PGL_DOUBLE:
+			return PGL_DOUBLE_STRING;
+			break;
+		case PGL_SINGLE:
+			return PGL_SINGLE_STRING;
+			break;
+		default:
+			pgp_switch_default();
+			return PGS_CS_UNKNOWN;
+			break;
+	}
+}
+
+void pgl_init(pgs_pipeline_t* _pipeline)
+{
+	unsigned long long input_block_size = _pipeline->fec == PGF_NONE ? 1 : pgf_get_input_block_size(_pipeline->fec);
+	unsigned long long output_block_size = _pipeline->fec == PGF_NONE ? 1 : pgf_get_output_block_size(_pipeline->fec);
+	unsigned long long chunk_codewords = PGL_CHUNK_SYMBOLS / output_block_size;
+	if (unlikely(chunk_codewords == 0))
+		chunk_codewords = 1;
+
+	_pipeline->chunk_bits = chunk_codewords * input_block_size * pgm_get_block_size(_pipeline->modulation);
+
+	_pipeline->transmit_arenas = pgt_alloc(PGL_ROUND_CHUNKS, sizeof(pgs_arena_t*));
+	for (unsigned long long i = 0; i < PGL_ROUND_CHUNKS; i++)
+		_pipeline->transmit_arenas[i] = pga_create();
+}
+
+void pgl_done(pgs_pipeline_t* _pipeline)
+{
+	for (unsigned long long i = 0; i < PGL_ROUND_CHUNKS; i++)
+		pga_destroy(_pipeline->transmit_arenas[i]);
+	free(_pipeline->transmit_arenas);
+}
+
+static void pgl_modulate(pgs_pipeline_t* _pipeline,
+		pgs_transmission_t* _transmission,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
+{
+	_transmission->modulated_signals_count =
+		pgm_modulate_soa(&_transmission->modulated_signals,
+				_transmission->premodulated_blocks,
+				_transmission->premodulated_blocks_count,
+				_pipeline->modulation,
+				_arena);
+	if (unlikely(_transmission->modulated_signals_count == 0))
+		pgp_nodata();
+
+	_transmission->noise = (pgs_signals_t){NULL, NULL};
+	_transmission->fading = (pgs_signals_t){NULL, NULL};
+	if (_pipeline->common_noise)
+		if (unlikely(pgc_draw_noise(&_transmission->noise,
+					&_transmission->fading,
+					_transmission->modulated_signals_count,
+					_pipeline->channel,
+					_context,
+					_arena) == 0))
+			pgp_nodata();
+}
+
+static void pgl_modulate_f(pgs_pipeline_t* _pipeline,
+		pgs_transmission_t* _transmission,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
+{
+	_transmission->modulated_signals_count =
+		pgm_modulate_soa_f(&_transmission->modulated_signals_f,
+				_transmission->premodulated_blocks,
+				_transmission->premodulated_blocks_count,
+				_pipeline->modulation,
+				_arena);
+	if (unlikely(_transmission->modulated_signals_count == 0))
+		pgp_nodata();
+
+	_transmission->noise_f = (pgs_signals_f_t){NULL, NULL};
+	_transmission->fading_f = (pgs_signals_f_t){NULL, NULL};
+	if (_pipeline->common_noise)
+		if (unlikely(pgc_draw_noise_f(&_transmission->noise_f,
+					&_transmission->fading_f,
+					_transmission->modulated_signals_count,
+					_pipeline->channel,
+					_context,
+					_arena) == 0))
+			pgp_nodata();
+}
+
+static unsigned long long pgl_demodulate(pgs_pipeline_t* _pipeline,
+		pgs_transmission_t* _transmission,
+		pgs_block_t** _demodulated_blocks,
+		double _hsquare,
+		pgs_context_t* _context)
+{
+	pgs_signals_t noised_signals;
+
+	unsigned long long noised_signals_count = _pipeline->common_noise ?
+		pgc_apply_noise(&noised_signals,
+				&_transmission->modulated_signals,
+				&_transmission->noise,
+				&_transmission->fading,
+				_transmission->modulated_signals_count,
+				_pipeline->channel,
+				_hsquare,
+				&_context->arena) :
+		pgc_add_noise_soa(&noised_signals,
+				&_transmission->modulated_signals,
+				_transmission->modulated_signals_count,
+				_pipeline->channel,
+				_hsquare,
+				_context,
+				&_context->arena);
+	if (unlikely(noised_signals_count == 0))
+		pgp_nodata();
+
+	return pgm_demodulate_soa(_demodulated_blocks,
+			&noised_signals,
+			noised_signals_count,
+			_pipeline->modulation,
+			&_context->arena);
+}
+
+static unsigned long long pgl_demodulate_f(pgs_pipeline_t* _pipeline,
+		pgs_transmission_t* _transmission,
+		pgs_block_t** _demodulated_blocks,
+		double _hsquare,
+		pgs_context_t* _context)
+{
+	pgs_signals_f_t noised_signals;
+
+	unsigned long long noised_signals_count = _pipeline->common_noise ?
+		pgc_apply_noise_f(&noised_signals,
+				&_transmission->modulated_signals_f,
+				&_transmission->noise_f,
+				&_transmission->fading_f,
+				_transmission->modulated_signals_count,
+				_pipeline->channel,
+				_hsquare,
+				&_context->arena) :
+		pgc_add_noise_soa_f(&noised_signals,
+				&_transmission->modulated_signals_f,
+				_transmission->modulated_signals_count,
+				_pipeline->channel,
+				_hsquare,
+				_context,
+				&_context->arena);
+	if (unlikely(noised_signals_count == 0))
+		pgp_nodata();
+
+	return pgm_demodulate_soa_f(_demodulated_blocks,
+			&noised_signals,
+			noised_signals_count,
+			_pipeline->modulation,
+			&_context->arena);
+}
+
+static void pgl_transmit(pgs_pipeline_t* _pipeline,
+		pgs_transmission_t* _transmission,
+		unsigned long long _offset,
+		unsigned long long _length,
+		pgs_context_t* _context,
+		pgs_arena_t* _arena)
+{
+	pgs_block_t* encoded_blocks = NULL;
+
+	_transmission->sequence_length =
+		pgs_generate(&_transmission->source,
+				_pipeline->source,
+				_pipeline->modulation,
+				_length,
+				_offset,
+				_arena);
+	if (unlikely(_transmission->sequence_length == 0))
+		pgp_nodata();
+
+	_transmission->source_blocks_count =
+		pgt_blocks_to_blocks(&_transmission->source_blocks,
+				_transmission->source,
+				1,
+				pgf_get_input_block_size(_pipeline->fec),
+				_arena);
+	if (unlikely(_transmission->source_blocks_count == 0))
+		pgp_nodata();
+
+	unsigned long long encoded_blocks_count = pgf_has_codebook(_pipeline->fec) ?
+		pgf_encode_stream(&encoded_blocks,
+				_transmission->source,
+				_transmission->sequence_length,
+				_pipeline->fec,
+				_arena) :
+		pgf_encode_blocks(&encoded_blocks,
+				_transmission->source_blocks,
+				_transmission->source_blocks_count,
+				_pipeline->fec,
+				_arena);
+	if (unlikely(encoded_blocks_count == 0))
+		pgp_nodata();
+
+	_transmission->premodulated_blocks_count =
+		pgt_blocks_to_blocks(&_transmission->premodulated_blocks,
+				encoded_blocks,
+				encoded_blocks_count,
+				pgm_get_block_size(_pipeline->modulation),
+				_arena);
+	if (unlikely(_transmission->premodulated_blocks_count == 0))
+		pgp_nodata();
+
+	switch (_pipeline->precision)
+	{
+		case PGL_DOUBLE:
+			pgl_modulate(_pipeline, _transmission, _context, _arena);
+			break;
+		case PGL_SINGLE:
+			pgl_modulate_f(_pipeline, _transmission, _context, _arena);
+			break;
+		default:
+			pgp_switch_default();
+			break;
+	}
+}
+
+static void pgl_receive(pgs_pipeline_t* _pipeline,
+		pgs_transmission_t* _transmission,
+		pgs_errors_t* _errors,
+		double _hsquare,
+		pgs_context_t* _context)
+{
+	pgs_block_t* demodulated_blocks = NULL;
+	pgs_block_t* predecoded_blocks = NULL;
+	pgs_block_t* decoded_blocks = NULL;
+	pgs_block_t* target_blocks = NULL;
+
+	unsigned long long demodulated_blocks_count = 0;
+	switch (_pipeline->precision)
+	{
+		case PGL_DOUBLE:
+			demodulated_blocks_count = pgl_demodulate(_pipeline, _transmission, &demodulated_blocks, _hsquare, _context);
+			break;
+		case PGL_SINGLE:
+			demodulated_blocks_count = pgl_demodulate_f(_pipeline, _transmission, &demodulated_blocks, _hsquare, _context);
+			break;
+		default:
+			pgp_switch_default();
+			break;
+	}
+	if (unlikely(demodulated_blocks_count == 0))
+		pgp_nodata();
+
+	unsigned long long predecoded_blocks_count =
+		pgt_blocks_to_blocks(&predecoded_blocks,
+				demodulated_blocks,
+				demodulated_blocks_count,
+				_pipeline->fec == PGF_NONE ? _transmission->sequence_length : pgf_get_output_block_size(_pipeline->fec),
+				&_context->arena);
+	if (unlikely(predecoded_blocks_count == 0))
+		pgp_nodata();
+
+	unsigned long long decoded_blocks_count =
+		pgf_decode_blocks(&decoded_blocks,
+				predecoded_blocks,
+				predecoded_blocks_count,
+				_pipeline->fec,
+				&_context->arena);
+	if (unlikely(decoded_blocks_count == 0))
+		pgp_nodata();
+
+	unsigned long long target_blocks_count =
+		pgt_blocks_to_blocks(&target_blocks,
+				decoded_blocks,
+				decoded_blocks_count,
+				_transmission->sequence_length,
+				&_context->arena);
+	if (unlikely(target_blocks_count == 0))
+		pgp_nodata();
+
+	_errors->bits += _transmission->sequence_length;
+	_errors->wrong_bits += pgt_count_wrong_bits(_transmission->source,
+			target_blocks,
+			_transmission->sequence_length);
+	if (_pipeline->fec == PGF_NONE)
+	{
+		_errors->symbols += _transmission->premodulated_blocks_count;
+		_errors->wrong_symbols += pgt_count_wrong_blocks(_transmission->premodulated_blocks,
+				demodulated_blocks,
+				_transmission->premodulated_blocks_count);
+	} else
+	{
+		_errors->symbols += _transmission->source_blocks_count;
+		_errors->wrong_symbols += pgt_count_wrong_blocks(_transmission->source_blocks,
+				decoded_blocks,
+				_transmission->source_blocks_count);
+	}
+}
+
+static unsigned int pgl_point_done(pgs_pipeline_t* _pipeline,
+		pgs_errors_t* _errors,
+		unsigned long long _iterations)
+{
+	unsigned long long wrong = _pipeline->error == PGE_SER ? _errors->wrong_symbols : _errors->wrong_bits;
+	unsigned long long total = _pipeline->error == PGE_SER ? _errors->symbols : _errors->bits;
+
+	if (_errors->bits >= _iterations)
+		return 1;
+	if (_pipeline->target_errors > 0 && wrong >= _pipeline->target_errors)
+		return 1;
+	if (_pipeline->confidence > 0 && wrong > 0)
+	{
+		double rate = (double)wrong / (double)total;
+		if (PGL_CONFIDENCE_Z * sqrt((1.0 - rate) / (double)wrong) <= _pipeline->confidence)
+			return 1;
+	}
+
+	return 0;
+}
+
+void pgl_run(pgs_pipeline_t* _pipeline,
+		pgs_errors_t* _errors,
+		double* _hsquares,
+		unsigned long long _points_count,
+		unsigned long long _iterations)
+{
+	unsigned long long chunks_count = (_iterations + _pipeline->chunk_bits - 1) / _pipeline->chunk_bits;
+	unsigned long long active_points_count = _points_count;
+	unsigned long long next_chunk = 0;
+	unsigned int* active = pgt_alloc(_points_count, sizeof(unsigned int));
+	pgs_transmission_t* transmissions = pgt_alloc(PGL_ROUND_CHUNKS, sizeof(pgs_transmission_t));
+	pgs_errors_t* round_errors = pgt_alloc_aligned(PGL_ROUND_CHUNKS * _points_count, sizeof(pgs_errors_t));
+
+	for (unsigned long long j = 0; j < _points_count; j++)
+	{
+		_errors[j] = (pgs_errors_t){0, 0, 0, 0};
+		active[j] = 1;
+	}
+
+	while (next_chunk < chunks_count && active_points_count > 0)
+	{
+		unsigned long long round_end = next_chunk + PGL_ROUND_CHUNKS < chunks_count ?
+			next_chunk + PGL_ROUND_CHUNKS : chunks_count;
+
+#if defined(_OPENMP)
+#pragma omp parallel
+#pragma omp single
+#endif
+		for (unsigned long long i = next_chunk; i < round_end; i++)
+		{
+#if defined(_OPENMP)
+#pragma omp task firstprivate(i)
+#endif
+			{
+				unsigned long long slot = i - next_chunk;
+				unsigned long long offset = i * _pipeline->chunk_bits;
+				unsigned long long length = _iterations - offset < _pipeline->chunk_bits ?
+					_iterations - offset : _pipeline->chunk_bits;
+
+				pgs_context_t* context = pgt_get_context();
+
+				__pgr_set_stream(context, PGL_TRANSMIT_STREAM, i);
+				pgl_transmit(_pipeline, &transmissions[slot], offset, length, context, _pipeline->transmit_arenas[slot]);
+				for (unsigned long long j = 0; j < _points_count; j++)
+				{
+					if (!active[j])
+						continue;
+#if defined(_OPENMP)
+#pragma omp task firstprivate(i, slot, j)
+#endif
+					{
+						pgs_context_t* context = pgt_get_context();
+
+						__pgr_set_stream(context, j, i);
+						pgl_receive(_pipeline,
+								&transmissions[slot],
+								&round_errors[slot * _points_count + j],
+								_hsquares[j],
+								context);
+						pga_reset(&context->arena);
+					}
+				}
+			}
+		}
+
+		for (unsigned long long i = 0; i < round_end - next_chunk; i++)
+			pga_reset(_pipeline->transmit_arenas[i]);
+
+		for (unsigned long long j = 0; j < _points_count; j++)
+			for (unsigned long long i = 0; i < round_end - next_chunk; i++)
+			{
+				pgs_errors_t* current_errors = &round_errors[i * _points_count + j];
+				if (active[j])
+				{
+					_errors[j].bits += current_errors->bits;
+					_errors[j].wrong_bits += current_errors->wrong_bits;
+					_errors[j].symbols += current_errors->symbols;
+					_errors[j].wrong_symbols += current_errors->wrong_symbols;
+					if (pgl_point_done(_pipeline, &_errors[j], _iterations))
+					{
+						active[j] = 0;
+						active_points_count--;
+					}
+				}
+				*current_errors = (pgs_errors_t){0, 0, 0, 0};
+			}
+
+		next_chunk = round_end;
+	}
+
+	free(round_errors);
+	free(transmissions);
+	free(active);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef PEGASUS_PIPELINE_H
+#define PEGASUS_PIPELINE_H
+
+/**
+ * @author Oleksandr Natalenko aka post-factum <oleksandr@natalenko.name>
+ *
+ * @section LICENSE
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ *
+ * pegasus — digital channel simulator, pipeline file header
+ */
+
+#include "pegasus_common_types.h"
+
+#define PGL_DOUBLE	1
+#define PGL_SINGLE	2
+
+#define PGL_DOUBLE_STRING	"Double (64-bit floating point)"
+#define PGL_SINGLE_STRING	"Single (32-bit floating point)"
+
+#define PGL_CHUNK_SYMBOLS	2048
+#define PGL_ROUND_CHUNKS	64
+#define PGL_CONFIDENCE_Z	1.96
+#define PGL_TRANSMIT_STREAM	0xfffffffeULL
+
+char* pgl_precision_to_string(unsigned int _precision);
+void pgl_init(pgs_pipeline_t* _pipeline);
+void pgl_done(pgs_pipeline_t* _pipeline);
+void pgl_run(pgs_pipeline_t* _pipeline,
+		pgs_errors_t* _errors,
+		double* _hsquares,
+		unsigned long long _points_count,
+		unsigned long long _iterations);
+
+#endif /* PEGASUS_PIPELINE_H */
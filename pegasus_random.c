@@ -22,7 +22,11 @@
 #include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 #include "pegasus_common_types.h"
 
@@ -31,62 +35,381 @@
 
 #include "pegasus_random.h"
 
-void pgr_init_seed()
+static void pgr_init_ziggurat()
+{
+	double d = PGR_ZIGGURAT_R;
+	double t = d;
+	double q = PGR_ZIGGURAT_V / exp(-0.5 * d * d);
+
+	pgr_ziggurat_k[0] = (uint64_t)((d / q) * PGR_ZIGGURAT_SCALE);
+	pgr_ziggurat_k[1] = 0;
+	pgr_ziggurat_w[0] = q / PGR_ZIGGURAT_SCALE;
+	pgr_ziggurat_w[PGR_ZIGGURAT_LAYERS - 1] = d / PGR_ZIGGURAT_SCALE;
+	pgr_ziggurat_f[0] = 1.0;
+	pgr_ziggurat_f[PGR_ZIGGURAT_LAYERS - 1] = exp(-0.5 * d * d);
+
+	for (unsigned long long i = PGR_ZIGGURAT_LAYERS - 2; i >= 1; i--)
+	{
+		d = sqrt(-2.0 * log(PGR_ZIGGURAT_V / d + exp(-0.5 * d * d)));
+		pgr_ziggurat_k[i + 1] = (uint64_t)((d / t) * PGR_ZIGGURAT_SCALE);
+		t = d;
+		pgr_ziggurat_f[i] = exp(-0.5 * d * d);
+		pgr_ziggurat_w[i] = d / PGR_ZIGGURAT_SCALE;
+	}
+}
+
+uint64_t pgr_time_seed()
 {
 	struct timespec current_time, next_time;
-	pgr_seed = pgt_alloc(pgt_threads, sizeof(uint64_t));
+	unsigned long long ns_diff;
+	uint64_t ret;
+
+	do
+	{
+		if (unlikely(clock_gettime(CLOCK_REALTIME, &current_time) != 0))
+			pgp_clock_gettime();
+		if (unlikely(clock_gettime(CLOCK_REALTIME, &next_time) != 0))
+			pgp_clock_gettime();
+		ns_diff = next_time.tv_sec * 1000000000ULL + next_time.tv_nsec -
+			current_time.tv_sec * 1000000000ULL - current_time.tv_nsec;
+	} while (ns_diff < PGS_UINT64_SIZE);
+
+	ret = current_time.tv_sec * 1000000000L + current_time.tv_nsec;
+
+	for (unsigned long long j = PGS_UINT64_SIZE - 1; j >= 1; j--)
+	{
+		unsigned long long current_random = ns_diff % j;
+		unsigned int bit1 = !!(ret & 1ULL << current_random);
+		unsigned int bit2 = !!(ret & 1ULL << j);
+		if (likely(bit1 != bit2))
+		{
+			ret ^= 1ULL << current_random;
+			ret ^= 1ULL << j;
+		}
+	}
+
+	return ret;
+}
+
+static uint64_t pgr_splitmix64(uint64_t* _state)
+{
+	uint64_t z = (*_state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+void pgr_init_seed(uint64_t _seed)
+{
+	pgr_init_ziggurat();
 
 	for (unsigned long long i = 0; i < pgt_threads; i++)
 	{
-		unsigned long long ns_diff;
+		uint64_t splitmix = _seed ^ i * 0xd1b54a32d192ed03ULL;
 		do
+			pgt_contexts[i].seed = pgr_splitmix64(&splitmix);
+		while (unlikely(pgt_contexts[i].seed == 0));
+
+		pgt_contexts[i].rng.key[0] = (uint32_t)_seed;
+		pgt_contexts[i].rng.key[1] = (uint32_t)(_seed >> 32);
+		__pgr_set_stream(&pgt_contexts[i], PGR_THREAD_STREAM, i);
+	}
+}
+
+void __pgr_set_stream(pgs_context_t* _context, unsigned long long _point, unsigned long long _chunk)
+{
+	_context->rng.counter[0] = 0;
+	_context->rng.counter[1] = (uint32_t)_chunk;
+	_context->rng.counter[2] = (uint32_t)(_chunk >> 32);
+	_context->rng.counter[3] = (uint32_t)_point;
+}
+
+uint64_t __pgr_get_u64(pgs_context_t* _context)
+{
+	uint64_t seed = _context->seed;
+
+	seed ^= seed << 21;
+	seed ^= seed >> 35;
+	seed ^= seed << 4;
+
+	return _context->seed = seed;
+}
+
+double __pgr_get_lf(pgs_context_t* _context)
+{
+	return (double)__pgr_get_u64(_context) / (double)PGS_UINT64_MAX;
+}
+
+double __pgr_get_gauss(pgs_context_t* _context)
+{
+	double ret;
+
+	__pgr_fill_gauss(_context, &ret, 1, 1.0);
+
+	return ret;
+}
+
+float __pgr_get_f(pgs_context_t* _context)
+{
+	return (float)(__pgr_get_u64(_context) >> 40) * 0x1p-24f;
+}
+
+float __pgr_get_gauss_f(pgs_context_t* _context)
+{
+	return (float)__pgr_get_gauss(_context);
+}
+
+static inline void pgr_next_lanes(pgs_rng_t* _rng, uint64_t* _result)
+{
+#if defined(__AVX512F__)
+	__m512i low = _mm512_set1_epi64(0xffffffffULL);
+	__m512i c0 = _mm512_add_epi64(_mm512_set1_epi64(_rng->counter[0]), _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+	__m512i c1 = _mm512_set1_epi64(_rng->counter[1]);
+	__m512i c2 = _mm512_set1_epi64(_rng->counter[2]);
+	__m512i c3 = _mm512_set1_epi64(_rng->counter[3]);
+	uint32_t k0 = _rng->key[0];
+	uint32_t k1 = _rng->key[1];
+
+	c0 = _mm512_and_si512(c0, low);
+	for (unsigned int round = 0; round < PGR_PHILOX_ROUNDS; round++)
+	{
+		__m512i p0 = _mm512_mul_epu32(c0, _mm512_set1_epi64(PGR_PHILOX_M0));
+		__m512i p1 = _mm512_mul_epu32(c2, _mm512_set1_epi64(PGR_PHILOX_M1));
+
+		c0 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p1, 32), c1), _mm512_set1_epi64(k0));
+		c1 = _mm512_and_si512(p1, low);
+		c2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p0, 32), c3), _mm512_set1_epi64(k1));
+		c3 = _mm512_and_si512(p0, low);
+		k0 += PGR_PHILOX_W0;
+		k1 += PGR_PHILOX_W1;
+	}
+
+	_mm512_storeu_si512(&_result[0], _mm512_or_si512(_mm512_slli_epi64(c1, 32), c0));
+	_mm512_storeu_si512(&_result[PGS_RNG_LANES], _mm512_or_si512(_mm512_slli_epi64(c3, 32), c2));
+#elif defined(__AVX2__)
+	for (unsigned int half = 0; half < PGS_RNG_LANES; half += 4)
+	{
+		__m256i low = _mm256_set1_epi64x(0xffffffffULL);
+		__m256i c0 = _mm256_add_epi64(_mm256_set1_epi64x(_rng->counter[0]), _mm256_set_epi64x(half + 3, half + 2, half + 1, half));
+		__m256i c1 = _mm256_set1_epi64x(_rng->counter[1]);
+		__m256i c2 = _mm256_set1_epi64x(_rng->counter[2]);
+		__m256i c3 = _mm256_set1_epi64x(_rng->counter[3]);
+		uint32_t k0 = _rng->key[0];
+		uint32_t k1 = _rng->key[1];
+
+		c0 = _mm256_and_si256(c0, low);
+		for (unsigned int round = 0; round < PGR_PHILOX_ROUNDS; round++)
+		{
+			__m256i p0 = _mm256_mul_epu32(c0, _mm256_set1_epi64x(PGR_PHILOX_M0));
+			__m256i p1 = _mm256_mul_epu32(c2, _mm256_set1_epi64x(PGR_PHILOX_M1));
+
+			c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), _mm256_set1_epi64x(k0));
+			c1 = _mm256_and_si256(p1, low);
+			c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), _mm256_set1_epi64x(k1));
+			c3 = _mm256_and_si256(p0, low);
+			k0 += PGR_PHILOX_W0;
+			k1 += PGR_PHILOX_W1;
+		}
+
+		_mm256_storeu_si256((__m256i*)&_result[half], _mm256_or_si256(_mm256_slli_epi64(c1, 32), c0));
+		_mm256_storeu_si256((__m256i*)&_result[half + PGS_RNG_LANES], _mm256_or_si256(_mm256_slli_epi64(c3, 32), c2));
+	}
+#else
+	uint32_t c0[PGS_RNG_LANES], c1[PGS_RNG_LANES], c2[PGS_RNG_LANES], c3[PGS_RNG_LANES];
+	uint32_t k0 = _rng->key[0];
+	uint32_t k1 = _rng->key[1];
+
+	for (unsigned int k = 0; k < PGS_RNG_LANES; k++)
+	{
+		c0[k] = _rng->counter[0] + k;
+		c1[k] = _rng->counter[1];
+		c2[k] = _rng->counter[2];
+		c3[k] = _rng->counter[3];
+	}
+
+	for (unsigned int round = 0; round < PGR_PHILOX_ROUNDS; round++)
+	{
+		for (unsigned int k = 0; k < PGS_RNG_LANES; k++)
 		{
-			if (unlikely(clock_gettime(CLOCK_REALTIME, &current_time) != 0))
-				pgp_clock_gettime();
-			if (unlikely(clock_gettime(CLOCK_REALTIME, &next_time) != 0))
-				pgp_clock_gettime();
-			ns_diff = next_time.tv_sec * 1000000000ULL + next_time.tv_nsec -
-				current_time.tv_sec * 1000000000ULL - current_time.tv_nsec;
-		} while (ns_diff < PGS_UINT64_SIZE);
+			uint64_t p0 = PGR_PHILOX_M0 * c0[k];
+			uint64_t p1 = PGR_PHILOX_M1 * c2[k];
+
+			c0[k] = (uint32_t)(p1 >> 32) ^ c1[k] ^ k0;
+			c1[k] = (uint32_t)p1;
+			c2[k] = (uint32_t)(p0 >> 32) ^ c3[k] ^ k1;
+			c3[k] = (uint32_t)p0;
+		}
+		k0 += PGR_PHILOX_W0;
+		k1 += PGR_PHILOX_W1;
+	}
+
+	for (unsigned int k = 0; k < PGS_RNG_LANES; k++)
+	{
+		_result[k] = (uint64_t)c1[k] << 32 | c0[k];
+		_result[k + PGS_RNG_LANES] = (uint64_t)c3[k] << 32 | c2[k];
+	}
+#endif
+
+	_rng->counter[0] += PGS_RNG_LANES;
+}
+
+void __pgr_fill_u64(pgs_context_t* _context, uint64_t* _buffer, unsigned long long _count)
+{
+	pgs_rng_t rng = _context->rng;
+	unsigned long long i = 0;
+
+	for (; i + PGR_PHILOX_OUTPUTS <= _count; i += PGR_PHILOX_OUTPUTS)
+		pgr_next_lanes(&rng, &_buffer[i]);
+	if (i < _count)
+	{
+		uint64_t tail[PGR_PHILOX_OUTPUTS];
+		pgr_next_lanes(&rng, tail);
+		memcpy(&_buffer[i], tail, (_count - i) * sizeof(uint64_t));
+	}
 
-		pgr_seed[i] = current_time.tv_sec * 1000000000L + current_time.tv_nsec;
+	_context->rng = rng;
+}
 
-		for (unsigned long long j = PGS_UINT64_SIZE - 1; j >= 1; j--)
+void __pgr_fill_lf(pgs_context_t* _context, double* _buffer, unsigned long long _count)
+{
+	uint64_t random[PGR_BATCH_SIZE];
+
+	for (unsigned long long i = 0; i < _count; i += PGR_BATCH_SIZE)
+	{
+		unsigned long long batch = _count - i < PGR_BATCH_SIZE ? _count - i : PGR_BATCH_SIZE;
+		__pgr_fill_u64(_context, random, batch);
+		for (unsigned long long j = 0; j < batch; j++)
+			_buffer[i + j] = (double)(random[j] >> 11) * 0x1p-53;
+	}
+}
+
+static inline uint64_t pgr_take_spare(pgs_context_t* _context, uint64_t* _spare, unsigned long long* _spare_used)
+{
+	if (unlikely(*_spare_used == PGR_PHILOX_OUTPUTS))
+	{
+		__pgr_fill_u64(_context, _spare, PGR_PHILOX_OUTPUTS);
+		*_spare_used = 0;
+	}
+
+	return _spare[(*_spare_used)++];
+}
+
+static inline double pgr_take_spare_lf(pgs_context_t* _context, uint64_t* _spare, unsigned long long* _spare_used)
+{
+	return (double)(pgr_take_spare(_context, _spare, _spare_used) >> 11) * 0x1p-53;
+}
+
+static double pgr_ziggurat_slow(pgs_context_t* _context, uint64_t* _spare, unsigned long long* _spare_used, uint64_t _random)
+{
+	while (1)
+	{
+		unsigned long long layer = _random & (PGR_ZIGGURAT_LAYERS - 1);
+		int64_t magnitude = (int64_t)_random >> 10;
+		double x = (double)magnitude * pgr_ziggurat_w[layer];
+
+		if ((uint64_t)llabs(magnitude) < pgr_ziggurat_k[layer])
+			return x;
+
+		if (layer == 0)
 		{
-			unsigned long long current_random = ns_diff % j;
-			unsigned int bit1 = !!(pgr_seed[i] & 1ULL << current_random);
-			unsigned int bit2 = !!(pgr_seed[i] & 1ULL << j);
-			if (likely(bit1 != bit2))
+			double y;
+			do
 			{
-				pgr_seed[i] ^= 1ULL << current_random;
-				pgr_seed[i] ^= 1ULL << j;
-			}
+				x = -log(1.0 - pgr_take_spare_lf(_context, _spare, _spare_used)) / PGR_ZIGGURAT_R;
+				y = -log(1.0 - pgr_take_spare_lf(_context, _spare, _spare_used));
+			} while (y + y < x * x);
+			return magnitude < 0 ? -(PGR_ZIGGURAT_R + x) : PGR_ZIGGURAT_R + x;
 		}
+
+		if (pgr_ziggurat_f[layer] + pgr_take_spare_lf(_context, _spare, _spare_used) *
+				(pgr_ziggurat_f[layer - 1] - pgr_ziggurat_f[layer]) < exp(-0.5 * x * x))
+			return x;
+
+		_random = pgr_take_spare(_context, _spare, _spare_used);
 	}
 }
 
-uint64_t __pgr_get_u64(unsigned long long _thread)
+static void pgr_fill_gauss_batch(pgs_context_t* _context,
+		double* restrict _target,
+		unsigned long long _batch,
+		double _sigma,
+		uint64_t* _spare,
+		unsigned long long* _spare_used)
 {
-	pgr_seed[_thread] ^= (pgr_seed[_thread] << 21);
-	pgr_seed[_thread] ^= (pgr_seed[_thread] >> 35);
-	pgr_seed[_thread] ^= (pgr_seed[_thread] << 4);
-	return pgr_seed[_thread];
+	uint64_t random[PGR_BATCH_SIZE];
+	unsigned long long j = 0;
+
+	__pgr_fill_u64(_context, random, _batch);
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+	for (; j + 8 <= _batch; j += 8)
+	{
+		__m512i value = _mm512_loadu_si512(&random[j]);
+		__m512i layer = _mm512_and_si512(value, _mm512_set1_epi64(PGR_ZIGGURAT_LAYERS - 1));
+		__m512i magnitude = _mm512_srai_epi64(value, 10);
+		__m512d w = _mm512_i64gather_pd(layer, pgr_ziggurat_w, sizeof(double));
+		__m512i k = _mm512_i64gather_epi64(layer, (const long long*)pgr_ziggurat_k, sizeof(uint64_t));
+
+		_mm512_storeu_pd(&_target[j], _mm512_mul_pd(_mm512_mul_pd(_mm512_cvtepi64_pd(magnitude), w), _mm512_set1_pd(_sigma)));
+		for (unsigned int rejected = _mm512_cmpge_epu64_mask(_mm512_abs_epi64(magnitude), k); rejected > 0; rejected &= rejected - 1)
+		{
+			unsigned long long index = j + __builtin_ctz(rejected);
+			_target[index] = pgr_ziggurat_slow(_context, _spare, _spare_used, random[index]) * _sigma;
+		}
+	}
+#elif defined(__AVX2__)
+	for (; j + 4 <= _batch; j += 4)
+	{
+		__m256i value = _mm256_loadu_si256((const __m256i*)&random[j]);
+		__m256i layer = _mm256_and_si256(value, _mm256_set1_epi64x(PGR_ZIGGURAT_LAYERS - 1));
+		__m256i sign = _mm256_set1_epi64x(1LL << 53);
+		__m256i magnitude = _mm256_sub_epi64(_mm256_xor_si256(_mm256_srli_epi64(value, 10), sign), sign);
+		__m256d w = _mm256_i64gather_pd(pgr_ziggurat_w, layer, sizeof(double));
+		__m256i k = _mm256_i64gather_epi64((const long long*)pgr_ziggurat_k, layer, sizeof(uint64_t));
+		__m256i one = _mm256_set1_epi64x(1);
+		__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(magnitude, _mm256_sub_epi64(k, one)),
+				_mm256_cmpgt_epi64(_mm256_sub_epi64(one, k), magnitude));
+		__m256i words = _mm256_permutevar8x32_epi32(value, _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0));
+		__m256d high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(words, 1));
+		__m256d low = _mm256_cvtepi32_pd(_mm_srli_epi32(_mm256_castsi256_si128(words), 10));
+		__m256d converted = _mm256_add_pd(_mm256_mul_pd(high, _mm256_set1_pd(0x1p22)), low);
+
+		_mm256_storeu_pd(&_target[j], _mm256_mul_pd(_mm256_mul_pd(converted, w), _mm256_set1_pd(_sigma)));
+		for (unsigned int rejected = _mm256_movemask_pd(_mm256_castsi256_pd(outside)); rejected > 0; rejected &= rejected - 1)
+		{
+			unsigned long long index = j + __builtin_ctz(rejected);
+			_target[index] = pgr_ziggurat_slow(_context, _spare, _spare_used, random[index]) * _sigma;
+		}
+	}
+#endif
+	for (; j < _batch; j++)
+		_target[j] = pgr_ziggurat_slow(_context, _spare, _spare_used, random[j]) * _sigma;
 }
 
-double __pgr_get_lf(unsigned long long _thread)
+void __pgr_fill_gauss(pgs_context_t* _context, double* _buffer, unsigned long long _count, double _sigma)
 {
-	return (double)__pgr_get_u64(_thread) / (double)PGS_UINT64_MAX;
+	uint64_t spare[PGR_PHILOX_OUTPUTS];
+	unsigned long long spare_used = PGR_PHILOX_OUTPUTS;
+
+	for (unsigned long long i = 0; i < _count; i += PGR_BATCH_SIZE)
+		pgr_fill_gauss_batch(_context,
+				&_buffer[i],
+				_count - i < PGR_BATCH_SIZE ? _count - i : PGR_BATCH_SIZE,
+				_sigma,
+				spare,
+				&spare_used);
 }
 
-double __pgr_get_gauss(unsigned long long _thread)
+void __pgr_fill_gauss_f(pgs_context_t* _context, float* _buffer, unsigned long long _count, float _sigma)
 {
-	double r, x, y;
-	do
+	double values[PGR_BATCH_SIZE];
+	uint64_t spare[PGR_PHILOX_OUTPUTS];
+	unsigned long long spare_used = PGR_PHILOX_OUTPUTS;
+
+	for (unsigned long long i = 0; i < _count; i += PGR_BATCH_SIZE)
 	{
-		x = 2.0 * __pgr_get_lf(_thread) - 1.0;
-		y = 2.0 * __pgr_get_lf(_thread) - 1.0;
-		r = pow(x, 2.0) + pow(y, 2.0);
-	} while (r > 1.0 || r == 0.0);
-	return x * sqrt(-2.0 * log(r) / r);
+		unsigned long long batch = _count - i < PGR_BATCH_SIZE ? _count - i : PGR_BATCH_SIZE;
+		pgr_fill_gauss_batch(_context, values, batch, _sigma, spare, &spare_used);
+		for (unsigned long long j = 0; j < batch; j++)
+			_buffer[i + j] = (float)values[j];
+	}
 }
-
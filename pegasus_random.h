@@ -24,38 +24,69 @@
  * pegasus — digital channel simulator, random file header
  */
 
-#if defined(_OPENMP)
-#include <omp.h>
-#endif
 #include <stdint.h>
 
 #include "pegasus_common_types.h"
 
-#if defined(_OPENMP)
-#define pgr_get_u64() \
-	__pgr_get_u64(omp_get_thread_num())
-#define pgr_get_lf() \
-	__pgr_get_lf(omp_get_thread_num())
-#define pgr_get_gauss() \
-	__pgr_get_gauss(omp_get_thread_num())
-#else
+#include "pegasus_tools.h"
+
 #define pgr_get_u64() \
-	__pgr_get_u64(0)
+	__pgr_get_u64(pgt_get_context())
 #define pgr_get_lf() \
-	__pgr_get_lf(0)
+	__pgr_get_lf(pgt_get_context())
 #define pgr_get_gauss() \
-	__pgr_get_gauss(0)
-#endif
+	__pgr_get_gauss(pgt_get_context())
+#define pgr_get_f() \
+	__pgr_get_f(pgt_get_context())
+#define pgr_get_gauss_f() \
+	__pgr_get_gauss_f(pgt_get_context())
+
+#define pgr_set_stream(_point, _chunk) \
+	__pgr_set_stream(pgt_get_context(), _point, _chunk)
+
+#define pgr_fill_u64(_buffer, _count) \
+	__pgr_fill_u64(pgt_get_context(), _buffer, _count)
+#define pgr_fill_lf(_buffer, _count) \
+	__pgr_fill_lf(pgt_get_context(), _buffer, _count)
+#define pgr_fill_gauss(_buffer, _count, _sigma) \
+	__pgr_fill_gauss(pgt_get_context(), _buffer, _count, _sigma)
+#define pgr_fill_gauss_f(_buffer, _count, _sigma) \
+	__pgr_fill_gauss_f(pgt_get_context(), _buffer, _count, _sigma)
+
+#define PGR_BATCH_SIZE	256
+
+#define PGR_PHILOX_ROUNDS	10
+#define PGR_PHILOX_M0		0xd2511f53ULL
+#define PGR_PHILOX_M1		0xcd9e8d57ULL
+#define PGR_PHILOX_W0		0x9e3779b9U
+#define PGR_PHILOX_W1		0xbb67ae85U
+#define PGR_PHILOX_OUTPUTS	(2 * PGS_RNG_LANES)
+#define PGR_THREAD_STREAM	0xffffffffULL
+
+#define PGR_ZIGGURAT_LAYERS	256
+#define PGR_ZIGGURAT_R		3.6541528853610088
+#define PGR_ZIGGURAT_V		0.00492867323399
+#define PGR_ZIGGURAT_SCALE	0x1p53
 
 #define PGR_UNIFORM	1
 #define PGR_GAUSSIAN	2
 
-uint64_t* pgr_seed;
+uint64_t pgr_ziggurat_k[PGR_ZIGGURAT_LAYERS];
+double pgr_ziggurat_w[PGR_ZIGGURAT_LAYERS];
+double pgr_ziggurat_f[PGR_ZIGGURAT_LAYERS];
 
-void pgr_init_seed();
-uint64_t __pgr_get_u64(unsigned long long _thread);
-double __pgr_get_lf(unsigned long long _thread);
-double __pgr_get_gauss(unsigned long long _thread);
+uint64_t pgr_time_seed();
+void pgr_init_seed(uint64_t _seed);
+void __pgr_set_stream(pgs_context_t* _context, unsigned long long _point, unsigned long long _chunk);
+uint64_t __pgr_get_u64(pgs_context_t* _context);
+double __pgr_get_lf(pgs_context_t* _context);
+double __pgr_get_gauss(pgs_context_t* _context);
+float __pgr_get_f(pgs_context_t* _context);
+float __pgr_get_gauss_f(pgs_context_t* _context);
+void __pgr_fill_u64(pgs_context_t* _context, uint64_t* _buffer, unsigned long long _count);
+void __pgr_fill_lf(pgs_context_t* _context, double* _buffer, unsigned long long _count);
+void __pgr_fill_gauss(pgs_context_t* _context, double* _buffer, unsigned long long _count, double _sigma);
+void __pgr_fill_gauss_f(pgs_context_t* _context, float* _buffer, unsigned long long _count, float _sigma);
 
 #endif /* PEGASUS_RANDOM_H */
 
@@ -22,14 +22,19 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "pegasus_common_strings.h"
 #include "pegasus_common_types.h"
 
+#include "pegasus_arena.h"
 #include "pegasus_block.h"
+#include "pegasus_channel.h"
+#include "pegasus_error.h"
 #include "pegasus_fec.h"
 #include "pegasus_modulation.h"
 #include "pegasus_panic.h"
+#include "pegasus_pipeline.h"
 #include "pegasus_random.h"
 #include "pegasus_source.h"
 #include "pegasus_tools.h"
@@ -58,7 +63,7 @@ static void pgst_show_result_lf(const char* _test_name,
 	printf("\t[%s"PGS_FG_COLOR_RESET" %s, %s, %s] got: %lf, should be: %lf\n", pass_mark, _test_name, _subtest_name, _result_name, _real_value, _desired_value);
 }
 
-static double pgst_rng_test(unsigned int _distribution)
+static double pgst_rng_test(unsigned int _distribution, unsigned int _moment)
 {
 	PGST_START_TEST();
 
@@ -78,11 +83,175 @@ static double pgst_rng_test(unsigned int _distribution)
 				pgp_switch_default();
 				break;
 		}
-		sum += summand / (double)PGST_RNG_ITERATIONS;
+		sum += pow(summand, _moment) / (double)PGST_RNG_ITERATIONS;
 	}
 	return sum;
 }
 
+static double pgst_gauss_tail_test(double _threshold)
+{
+	PGST_START_TEST();
+
+	unsigned long long tail = 0;
+	for (unsigned long long i = 0; i < PGST_RNG_ITERATIONS; i++)
+		if (fabs(pgr_get_gauss()) > _threshold)
+			tail++;
+
+	return (double)tail / (double)PGST_RNG_ITERATIONS;
+}
+
+static double pgst_bulk_rng_test(unsigned int _distribution, unsigned int _moment)
+{
+	PGST_START_TEST();
+
+	double* values = pgt_alloc(PGST_RNG_ITERATIONS, sizeof(double));
+	switch (_distribution)
+	{
+		case PGR_UNIFORM:
+			pgr_fill_lf(values, PGST_RNG_ITERATIONS);
+			break;
+		case PGR_GAUSSIAN:
+			pgr_fill_gauss(values, PGST_RNG_ITERATIONS, 1.0);
+			break;
+		default:
+			pgp_switch_default();
+			break;
+	}
+
+	double sum = 0;
+	for (unsigned long long i = 0; i < PGST_RNG_ITERATIONS; i++)
+		sum += pow(values[i], _moment) / (double)PGST_RNG_ITERATIONS;
+
+	free(values);
+
+	return sum;
+}
+
+static double pgst_bulk_gauss_f_test()
+{
+	PGST_START_TEST();
+
+	double* values = pgt_alloc(PGST_RNG_ITERATIONS, sizeof(double));
+	float* values_f = pgt_alloc(PGST_RNG_ITERATIONS, sizeof(float));
+	pgs_context_t* context = pgt_get_context();
+	pgs_rng_t saved_rng = context->rng;
+
+	__pgr_fill_gauss(context, values, PGST_RNG_ITERATIONS, 1.0);
+	context->rng = saved_rng;
+	__pgr_fill_gauss_f(context, values_f, PGST_RNG_ITERATIONS, 1.0f);
+
+	unsigned long long mismatches = 0;
+	for (unsigned long long i = 0; i < PGST_RNG_ITERATIONS; i++)
+		if (values_f[i] != (float)values[i])
+			mismatches++;
+
+	free(values);
+	free(values_f);
+
+	return (double)mismatches;
+}
+
+static double pgst_bulk_gauss_f_tail_test(double _threshold)
+{
+	PGST_START_TEST();
+
+	float* values = pgt_alloc(PGST_RNG_ITERATIONS, sizeof(float));
+	unsigned long long tail = 0;
+	for (unsigned long long i = 0; i < PGST_TAIL_ROUNDS; i++)
+	{
+		pgr_fill_gauss_f(values, PGST_RNG_ITERATIONS, 1.0f);
+		for (unsigned long long j = 0; j < PGST_RNG_ITERATIONS; j++)
+			if (fabsf(values[j]) > _threshold)
+				tail++;
+	}
+
+	free(values);
+
+	return (double)tail / ((double)PGST_TAIL_ROUNDS * (double)PGST_RNG_ITERATIONS) / erfc(_threshold / M_SQRT2);
+}
+
+static double pgst_philox_test()
+{
+	PGST_START_TEST();
+
+	static const uint32_t vectors[][10] =
+	{
+		{0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+			0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+		{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+			0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+		{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+			0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1},
+	};
+	pgs_context_t context;
+	uint64_t result[PGR_PHILOX_OUTPUTS];
+	unsigned long long wrong_words = 0;
+
+	memset(&context, 0, sizeof(pgs_context_t));
+	for (unsigned long long i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+	{
+		memcpy(context.rng.counter, &vectors[i][0], sizeof(context.rng.counter));
+		memcpy(context.rng.key, &vectors[i][4], sizeof(context.rng.key));
+		__pgr_fill_u64(&context, result, PGR_PHILOX_OUTPUTS);
+
+		uint32_t words[4] =
+		{
+			(uint32_t)result[0],
+			(uint32_t)(result[0] >> 32),
+			(uint32_t)result[PGS_RNG_LANES],
+			(uint32_t)(result[PGS_RNG_LANES] >> 32),
+		};
+		for (unsigned int j = 0; j < 4; j++)
+			if (words[j] != vectors[i][6 + j])
+				wrong_words++;
+	}
+
+	return (double)wrong_words;
+}
+
+static double pgst_error_counter_test(unsigned int _error)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* original_blocks = NULL;
+	pgs_block_t* distorted_blocks = NULL;
+	pgs_arena_t* arena = pga_create();
+	pgs_block_t* original = pgb_alloc_blocks(arena, 1, PGST_COUNTER_LENGTH);
+	pgs_block_t* distorted = pgb_alloc_blocks(arena, 1, PGST_COUNTER_LENGTH);
+	unsigned long long words = PGB_WORDS(PGST_COUNTER_LENGTH);
+	unsigned long long ret = 0;
+
+	pgr_fill_u64(original->chunk, words);
+	memcpy(distorted->chunk, original->chunk, words * sizeof(uint64_t));
+	distorted->chunk[words - 1] ^= ~PGB_HEAD_MASK(PGB_OFFSET(PGST_COUNTER_LENGTH));
+	for (unsigned long long i = 0; i < PGST_COUNTER_LENGTH; i += PGST_COUNTER_STRIDE)
+	{
+		pgb_flip_bit(distorted, i);
+		pgb_flip_bit(distorted, i + 1);
+	}
+
+	switch (_error)
+	{
+		case PGE_BER:
+			ret = pgt_count_wrong_bits(original, distorted, PGST_COUNTER_LENGTH);
+			break;
+		case PGE_SER:
+		{
+			unsigned long long blocks_count = pgt_blocks_to_blocks(&original_blocks, original, 1, CHAR_BIT, arena);
+			pgt_blocks_to_blocks(&distorted_blocks, distorted, 1, CHAR_BIT, arena);
+			ret = pgt_count_wrong_blocks(original_blocks, distorted_blocks, blocks_count);
+			break;
+		}
+		default:
+			pgp_switch_default();
+			break;
+	}
+
+	pga_destroy(arena);
+
+	return (double)ret;
+}
+
 static double pgst_fec_test(unsigned int _fec)
 {
 	PGST_START_TEST();
@@ -92,12 +261,15 @@ static double pgst_fec_test(unsigned int _fec)
 	pgs_block_t* encoded_blocks;
 	pgs_block_t* decoded_blocks;
 	pgs_block_t* target_blocks;
+	pgs_arena_t* arena = pga_create();
 	printf("\t%s\n", pgf_to_string(_fec));
 	unsigned long long source_bits_count =
 		pgs_generate(&source_bits,
 				PGS_RANDOM,
 				PGM_QPSK,
-				PGST_SOURCE_LENGTH);
+				PGST_SOURCE_LENGTH,
+				0,
+				arena);
 	if (unlikely(source_bits_count == 0))
 		pgp_nodata();
 	printf("\t\tGenerated sequence: ");
@@ -106,7 +278,8 @@ static double pgst_fec_test(unsigned int _fec)
 		pgt_blocks_to_blocks(&source_blocks,
 				source_bits,
 				1,
-				pgf_get_input_block_size(_fec));
+				pgf_get_input_block_size(_fec),
+				arena);
 	if (unlikely(source_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tBroken-out sequence: ");
@@ -115,7 +288,8 @@ static double pgst_fec_test(unsigned int _fec)
 		pgf_encode_blocks(&encoded_blocks,
 				source_blocks,
 				source_blocks_count,
-				_fec);
+				_fec,
+				arena);
 	if (unlikely(encoded_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tEncoded sequence: ");
@@ -124,7 +298,8 @@ static double pgst_fec_test(unsigned int _fec)
 		pgf_decode_blocks(&decoded_blocks,
 				encoded_blocks,
 				encoded_blocks_count,
-				_fec);
+				_fec,
+				arena);
 	if (unlikely(decoded_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tDecoded sequence: ");
@@ -133,7 +308,8 @@ static double pgst_fec_test(unsigned int _fec)
 		pgt_blocks_to_blocks(&target_blocks,
 				decoded_blocks,
 				decoded_blocks_count,
-				source_bits_count);
+				source_bits_count,
+				arena);
 	if (unlikely(target_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tJoint sequence: ");
@@ -143,15 +319,115 @@ static double pgst_fec_test(unsigned int _fec)
 			target_blocks,
 			source_bits_count);
 
-	pgb_destroy_blocks(target_blocks, target_blocks_count);
-	pgb_destroy_blocks(decoded_blocks, decoded_blocks_count);
-	pgb_destroy_blocks(encoded_blocks, encoded_blocks_count);
-	pgb_destroy_blocks(source_blocks, source_blocks_count);
-	pgb_destroy_block(source_bits);
+	pga_destroy(arena);
 
 	return ber;
 }
 
+static double pgst_correction_test(unsigned int _fec, unsigned long long _fec_power, unsigned long long _first_position)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* encoded_blocks;
+	pgs_block_t* decoded_blocks;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long input_block_size = pgf_get_input_block_size(_fec);
+	unsigned long long output_block_size = pgf_get_output_block_size(_fec);
+	pgs_block_t* source_blocks = pgb_alloc_blocks(arena, PGST_BCH_CODEWORDS, input_block_size);
+	unsigned long long ret = 0;
+
+	for (unsigned long long i = 0; i < PGST_BCH_CODEWORDS; i++)
+		pgr_fill_u64(source_blocks[i].chunk, PGB_WORDS(input_block_size));
+	pgf_encode_blocks(&encoded_blocks, source_blocks, PGST_BCH_CODEWORDS, _fec, arena);
+	for (unsigned long long i = 0; i < PGST_BCH_CODEWORDS; i++)
+		for (unsigned long long j = 0; j < i % _fec_power + 1; j++)
+			pgb_flip_bit(&encoded_blocks[i], _first_position +
+					(i + j * PGST_COUNTER_STRIDE) % (output_block_size - _first_position));
+	pgf_decode_blocks(&decoded_blocks, encoded_blocks, PGST_BCH_CODEWORDS, _fec, arena);
+	for (unsigned long long i = 0; i < PGST_BCH_CODEWORDS; i++)
+		ret += pgt_count_wrong_bits(&source_blocks[i], &decoded_blocks[i], input_block_size);
+
+	pga_destroy(arena);
+
+	return (double)ret;
+}
+
+static uint64_t pgst_decode_codeword(unsigned int _fec, pgs_block_t* _encoded_block)
+{
+	uint64_t* syndromes_table;
+	pgs_block_t* polynome;
+	unsigned long long input_block_size = pgf_get_input_block_size(_fec);
+	unsigned long long output_block_size = pgf_get_output_block_size(_fec);
+	uint64_t value = pgb_get_bits(_encoded_block, 0, output_block_size);
+
+	switch (_fec)
+	{
+		case PGF_HAMMING74:
+		{
+			unsigned long long wrong_bit = 0;
+			for (unsigned long long i = 0; i < PGF_HAMMING74_FEC_SUFFIX; i++)
+				wrong_bit = (wrong_bit << 1) | pgb_multixor(_encoded_block,
+						PGF_HAMMING74_SYNDROME_BITS[i],
+						PGF_HAMMING74_INPUT_BLOCK_SIZE);
+			if (wrong_bit > 0 && wrong_bit <= PGF_HAMMING74_INPUT_BLOCK_SIZE)
+				value ^= 1ULL << (output_block_size - wrong_bit);
+			return value >> PGF_HAMMING74_FEC_SUFFIX;
+			break;
+		}
+		case PGF_CYCLIC85:
+			syndromes_table = pgf_syndromes_cyclic85;
+			polynome = pgf_polynome_cyclic85;
+			break;
+		case PGF_BCH1557:
+			syndromes_table = pgf_syndromes_bch1557;
+			polynome = pgf_polynome_bch1557;
+			break;
+		case PGF_BCH1575:
+			syndromes_table = pgf_syndromes_bch1575;
+			polynome = pgf_polynome_bch1575;
+			break;
+		default:
+			pgp_switch_default();
+			return 0;
+			break;
+	}
+
+	unsigned long long degree = polynome->bits_count - 1;
+	uint64_t divisor = pgb_block_to_ull(polynome);
+	uint64_t syndrome = value;
+	for (unsigned long long i = output_block_size; i-- > degree;)
+		if ((syndrome >> i) & 1ULL)
+			syndrome ^= divisor << (i - degree);
+
+	return (value ^ syndromes_table[syndrome]) >> (output_block_size - input_block_size);
+}
+
+static double pgst_slice_test(unsigned int _fec)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* decoded_blocks;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long input_block_size = pgf_get_input_block_size(_fec);
+	unsigned long long output_block_size = pgf_get_output_block_size(_fec);
+	pgs_block_t* encoded_blocks = pgb_alloc_blocks(arena, PGST_SLICE_CODEWORDS, output_block_size);
+	unsigned long long ret = 0;
+
+	for (unsigned long long i = 0; i < PGST_SLICE_CODEWORDS; i++)
+	{
+		pgr_fill_u64(encoded_blocks[i].chunk, 1);
+		encoded_blocks[i].chunk[0] &= PGB_HEAD_MASK(output_block_size);
+	}
+	pgf_decode_blocks(&decoded_blocks, encoded_blocks, PGST_SLICE_CODEWORDS, _fec, arena);
+	for (unsigned long long i = 0; i < PGST_SLICE_CODEWORDS; i++)
+		if (pgb_get_bits(&decoded_blocks[i], 0, input_block_size) != pgst_decode_codeword(_fec, &encoded_blocks[i]))
+			ret++;
+
+	pga_destroy(arena);
+
+	return (double)ret;
+}
+
 static double pgst_modulator_test(unsigned int _modulation)
 {
 	PGST_START_TEST();
@@ -161,12 +437,15 @@ static double pgst_modulator_test(unsigned int _modulation)
 	pgs_signal_t* modulated_signals;
 	pgs_block_t* demodulated_blocks;
 	pgs_block_t* target_blocks;
+	pgs_arena_t* arena = pga_create();
 	printf("\t%s\n", pgm_to_string(_modulation));
 	unsigned long long source_bits_count =
 		pgs_generate(&source_bits,
 				PGS_RANDOM,
 				PGM_QPSK,
-				PGST_SOURCE_LENGTH);
+				PGST_SOURCE_LENGTH,
+				0,
+				arena);
 	if (unlikely(source_bits_count == 0))
 		pgp_nodata();
 	printf("\t\tGenerated sequence: ");
@@ -175,7 +454,8 @@ static double pgst_modulator_test(unsigned int _modulation)
 		pgt_blocks_to_blocks(&source_blocks,
 				source_bits,
 				1,
-				pgm_get_block_size(_modulation));
+				pgm_get_block_size(_modulation),
+				arena);
 	if (unlikely(source_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tBroken-out sequence: ");
@@ -184,14 +464,16 @@ static double pgst_modulator_test(unsigned int _modulation)
 		pgm_modulate(&modulated_signals,
 				source_blocks,
 				source_blocks_count,
-				_modulation);
+				_modulation,
+				arena);
 	if (unlikely(modulated_signals_count == 0))
 		pgp_nodata();
 	unsigned long long demodulated_blocks_count =
 		pgm_demodulate(&demodulated_blocks,
 				modulated_signals,
 				modulated_signals_count,
-				_modulation);
+				_modulation,
+				arena);
 	if (unlikely(demodulated_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tDemodulated sequence: ");
@@ -200,7 +482,8 @@ static double pgst_modulator_test(unsigned int _modulation)
 		pgt_blocks_to_blocks(&target_blocks,
 				demodulated_blocks,
 				demodulated_blocks_count,
-				source_bits_count);
+				source_bits_count,
+				arena);
 	if (unlikely(target_blocks_count == 0))
 		pgp_nodata();
 	printf("\t\tJoint sequence: ");
@@ -210,20 +493,457 @@ static double pgst_modulator_test(unsigned int _modulation)
 			target_blocks,
 			source_bits_count);
 
-	pgb_destroy_blocks(target_blocks, target_blocks_count);
-	pgb_destroy_blocks(demodulated_blocks, demodulated_blocks_count);
-	free(modulated_signals);
-	pgb_destroy_blocks(source_blocks, source_blocks_count);
-	pgb_destroy_block(source_bits);
+	pga_destroy(arena);
+
+	return ber;
+}
+
+static double pgst_nearest_distance(double _real_i, double _real_q, pgs_signal_t* _table, unsigned long long _table_size)
+{
+	double ret = INFINITY;
+	for (unsigned long long i = 0; i < _table_size; i++)
+		ret = fmin(ret, pgt_distance(_real_i, _real_q, _table[i].i, _table[i].q));
+
+	return ret;
+}
+
+static double pgst_demodulator_test(unsigned int _modulation, pgs_signal_t* _table)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* demodulated_blocks;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long table_size = pgm_get_volume(_modulation);
+	pgs_signal_t* signals = pga_alloc(arena, PGST_DEMODULATOR_POINTS, sizeof(pgs_signal_t));
+	unsigned long long ret = 0;
+
+	for (unsigned long long i = 0; i < PGST_DEMODULATOR_POINTS / 2; i++)
+	{
+		pgs_signal_t* symbol = &_table[pgr_get_u64() % table_size];
+		signals[i].i = symbol->i + PGST_DEMODULATOR_SIGMA * pgr_get_gauss();
+		signals[i].q = symbol->q + PGST_DEMODULATOR_SIGMA * pgr_get_gauss();
+	}
+	for (unsigned long long i = PGST_DEMODULATOR_POINTS / 2; i < PGST_DEMODULATOR_POINTS; i++)
+	{
+		pgs_signal_t* symbol = &_table[pgr_get_u64() % table_size];
+		double nearest = INFINITY;
+		for (unsigned long long j = 0; j < table_size; j++)
+			if (&_table[j] != symbol)
+				nearest = fmin(nearest, pgt_distance(symbol->i, symbol->q, _table[j].i, _table[j].q));
+
+		unsigned long long neighbours_count = 0;
+		pgs_signal_t* neighbours[PGST_DEMODULATOR_NEIGHBOURS];
+		for (unsigned long long j = 0; j < table_size && neighbours_count < PGST_DEMODULATOR_NEIGHBOURS; j++)
+			if (&_table[j] != symbol &&
+					pgt_distance(symbol->i, symbol->q, _table[j].i, _table[j].q) < PGST_DEMODULATOR_REACH * nearest)
+				neighbours[neighbours_count++] = &_table[j];
+		pgs_signal_t* neighbour = neighbours[pgr_get_u64() % neighbours_count];
+
+		double offset = PGST_DEMODULATOR_OFFSET * (double)((long long)(i % 3) - 1);
+		signals[i].i = (symbol->i + neighbour->i) / 2.0 + offset * (neighbour->i - symbol->i);
+		signals[i].q = (symbol->q + neighbour->q) / 2.0 + offset * (neighbour->q - symbol->q);
+	}
+
+	unsigned long long demodulated_blocks_count =
+		pgm_demodulate(&demodulated_blocks,
+				signals,
+				PGST_DEMODULATOR_POINTS,
+				_modulation,
+				arena);
+	if (unlikely(demodulated_blocks_count == 0))
+		pgp_nodata();
+
+	for (unsigned long long i = 0; i < demodulated_blocks_count; i++)
+	{
+		pgs_signal_t* found = &_table[pgb_block_to_ull(&demodulated_blocks[i])];
+		double distance = pgt_distance(signals[i].i, signals[i].q, found->i, found->q);
+		double nearest = pgst_nearest_distance(signals[i].i, signals[i].q, _table, table_size);
+		if (distance > nearest * (1.0 + PGST_DEMODULATOR_PRECISION))
+			ret++;
+	}
+
+	pga_destroy(arena);
+
+	return (double)ret;
+}
+
+static unsigned long long pgst_prepare_signals(pgs_block_t** _source_bits,
+		pgs_block_t** _source_blocks,
+		pgs_signals_t* _modulated_signals,
+		unsigned int _modulation,
+		unsigned long long _length,
+		pgs_arena_t* _arena)
+{
+	unsigned long long source_bits_count =
+		pgs_generate(_source_bits,
+				PGS_RANDOM,
+				_modulation,
+				_length,
+				0,
+				_arena);
+	if (unlikely(source_bits_count == 0))
+		pgp_nodata();
+	unsigned long long source_blocks_count =
+		pgt_blocks_to_blocks(_source_blocks,
+				*_source_bits,
+				1,
+				pgm_get_block_size(_modulation),
+				_arena);
+	if (unlikely(source_blocks_count == 0))
+		pgp_nodata();
+	if (_modulated_signals != NULL &&
+			unlikely(pgm_modulate_soa(_modulated_signals,
+					*_source_blocks,
+					source_blocks_count,
+					_modulation,
+					_arena) == 0))
+		pgp_nodata();
+
+	return source_blocks_count;
+}
+
+static double pgst_channel_test(unsigned int _channel)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* source_bits;
+	pgs_block_t* source_blocks;
+	pgs_signal_t* modulated_signals;
+	pgs_signal_t* noised_signals;
+	pgs_signals_t modulated_signals_soa, noised_signals_soa;
+	pgs_context_t* context = pgt_get_context();
+	pgs_rng_t saved_rng = context->rng;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long source_blocks_count =
+		pgst_prepare_signals(&source_bits,
+				&source_blocks,
+				&modulated_signals_soa,
+				PGM_QPSK,
+				PGST_CHANNEL_LENGTH,
+				arena);
+	unsigned long long modulated_signals_count =
+		pgm_modulate(&modulated_signals,
+				source_blocks,
+				source_blocks_count,
+				PGM_QPSK,
+				arena);
+	if (unlikely(modulated_signals_count == 0))
+		pgp_nodata();
+
+	__pgr_set_stream(context, 0, 0);
+	unsigned long long noised_signals_count =
+		pgc_add_noise(&noised_signals,
+				modulated_signals,
+				modulated_signals_count,
+				_channel,
+				1.0,
+				arena);
+	if (unlikely(noised_signals_count == 0))
+		pgp_nodata();
+	__pgr_set_stream(context, 0, 0);
+	pgc_add_noise_soa(&noised_signals_soa,
+			&modulated_signals_soa,
+			modulated_signals_count,
+			_channel,
+			1.0,
+			context,
+			arena);
+	context->rng = saved_rng;
+
+	double deviation = 0;
+	for (unsigned long long i = 0; i < noised_signals_count; i++)
+		deviation = fmax(deviation, fmax(fabs(noised_signals[i].i - noised_signals_soa.i[i]),
+					fabs(noised_signals[i].q - noised_signals_soa.q[i])));
+
+	pga_destroy(arena);
+
+	return deviation;
+}
+
+static double pgst_llr_test(unsigned int _modulation, unsigned int _method)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* source_bits;
+	pgs_block_t* source_blocks;
+	pgs_signal_t* modulated_signals;
+	float* llrs;
+	pgs_arena_t* arena = pga_create();
+	printf("\t%s, %s\n", pgm_to_string(_modulation), _method == PGM_LLR_MAX_LOG ? "max-log" : "log-MAP");
+	unsigned long long source_blocks_count =
+		pgst_prepare_signals(&source_bits,
+				&source_blocks,
+				NULL,
+				_modulation,
+				PGST_SOURCE_LENGTH,
+				arena);
+	unsigned long long modulated_signals_count =
+		pgm_modulate(&modulated_signals,
+				source_blocks,
+				source_blocks_count,
+				_modulation,
+				arena);
+	if (unlikely(modulated_signals_count == 0))
+		pgp_nodata();
+	unsigned long long llrs_count =
+		pgm_demodulate_llr(&llrs,
+				modulated_signals,
+				NULL,
+				modulated_signals_count,
+				_modulation,
+				_method,
+				10.0,
+				arena);
+	if (unlikely(llrs_count == 0))
+		pgp_nodata();
+
+	unsigned long long wrong_bits = 0;
+	for (unsigned long long i = 0; i < llrs_count; i++)
+		if ((llrs[i] < 0.0f) != (pgb_get_bit(source_bits, i) == 1))
+			wrong_bits++;
+
+	pga_destroy(arena);
+
+	return (double)wrong_bits / (double)llrs_count;
+}
+
+static void pgst_llr_noise(pgs_signals_t* _noised_signals,
+		pgs_signals_t* _fading,
+		pgs_block_t** _source_bits,
+		unsigned int _modulation,
+		unsigned int _channel,
+		double _hsquare,
+		pgs_arena_t* _arena)
+{
+	pgs_block_t* source_blocks;
+	pgs_signals_t modulated_signals, noise;
+	pgs_context_t* context = pgt_get_context();
+	pgs_rng_t saved_rng = context->rng;
+	unsigned long long source_blocks_count =
+		pgst_prepare_signals(_source_bits,
+				&source_blocks,
+				&modulated_signals,
+				_modulation,
+				PGST_CHANNEL_LENGTH,
+				_arena);
+
+	__pgr_set_stream(context, 0, 0);
+	pgc_draw_noise(&noise, _fading, source_blocks_count, _channel, context, _arena);
+	pgc_apply_noise(_noised_signals,
+			&modulated_signals,
+			&noise,
+			_fading,
+			source_blocks_count,
+			_channel,
+			_hsquare,
+			_arena);
+	context->rng = saved_rng;
+}
+
+static double pgst_llr_value_test(unsigned int _channel)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* source_bits;
+	pgs_signals_t noised_signals, fading;
+	float* llrs;
+	pgs_arena_t* arena = pga_create();
+	pgst_llr_noise(&noised_signals, &fading, &source_bits, PGM_BPSK, _channel, PGST_LLR_HSQUARE, arena);
+	unsigned long long llrs_count =
+		pgm_demodulate_llr_soa(&llrs,
+				&noised_signals,
+				&fading,
+				PGST_CHANNEL_LENGTH,
+				PGM_BPSK,
+				PGM_LLR_LOG_MAP,
+				PGST_LLR_HSQUARE,
+				arena);
+	if (unlikely(llrs_count == 0))
+		pgp_nodata();
+
+	double deviation = 0;
+	for (unsigned long long i = 0; i < llrs_count; i++)
+	{
+		double fading_power = fading.i == NULL ? 1.0 : fading.i[i] * fading.i[i] + fading.q[i] * fading.q[i];
+		double llr = 4.0 * PGST_LLR_HSQUARE * fading_power *
+			(noised_signals.i[i] * pgm_bpsk_table[0].i + noised_signals.q[i] * pgm_bpsk_table[0].q);
+		deviation = fmax(deviation, fabs((double)llrs[i] - llr) / fmax(1.0, fabs(llr)));
+	}
+
+	pga_destroy(arena);
+
+	return deviation;
+}
+
+static double pgst_llr_log_map_test(unsigned int _modulation, pgs_signal_t* _table)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* source_bits;
+	pgs_signals_t noised_signals, fading;
+	float* llrs;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long table_size = pgm_get_volume(_modulation);
+	unsigned long long block_size = pgm_get_block_size(_modulation);
+	unsigned long long signals_count = PGST_CHANNEL_LENGTH / block_size;
+	pgst_llr_noise(&noised_signals, &fading, &source_bits, _modulation, PGC_AWGN, PGST_LLR_HSQUARE, arena);
+	unsigned long long llrs_count =
+		pgm_demodulate_llr_soa(&llrs,
+				&noised_signals,
+				&fading,
+				signals_count,
+				_modulation,
+				PGM_LLR_LOG_MAP,
+				PGST_LLR_HSQUARE,
+				arena);
+	if (unlikely(llrs_count == 0))
+		pgp_nodata();
+
+	double deviation = 0;
+	for (unsigned long long i = 0; i < signals_count; i++)
+		for (unsigned long long k = 0; k < block_size; k++)
+		{
+			unsigned long long mask = 1ULL << (block_size - 1 - k);
+			double sums[2] = {0, 0};
+			for (unsigned long long j = 0; j < table_size; j++)
+			{
+				double di = noised_signals.i[i] - _table[j].i;
+				double dq = noised_signals.q[i] - _table[j].q;
+				sums[(j & mask) != 0] += exp(-PGST_LLR_HSQUARE * (di * di + dq * dq));
+			}
+			double llr = log(sums[0]) - log(sums[1]);
+			deviation = fmax(deviation, fabs((double)llrs[i * block_size + k] - llr) / fmax(1.0, fabs(llr)));
+		}
+
+	pga_destroy(arena);
+
+	return deviation;
+}
+
+static double pgst_llr_max_log_test(unsigned int _modulation)
+{
+	PGST_START_TEST();
+
+	pgs_block_t* source_bits;
+	pgs_signals_t noised_signals, fading;
+	float* max_log_llrs;
+	float* log_map_llrs;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long signals_count = PGST_CHANNEL_LENGTH / pgm_get_block_size(_modulation);
+	double bound = log((double)pgm_get_volume(_modulation) / 2.0);
+	pgst_llr_noise(&noised_signals, &fading, &source_bits, _modulation, PGC_AWGN, PGST_LLR_HSQUARE, arena);
+	unsigned long long llrs_count =
+		pgm_demodulate_llr_soa(&max_log_llrs,
+				&noised_signals,
+				&fading,
+				signals_count,
+				_modulation,
+				PGM_LLR_MAX_LOG,
+				PGST_LLR_HSQUARE,
+				arena);
+	if (unlikely(llrs_count == 0))
+		pgp_nodata();
+	pgm_demodulate_llr_soa(&log_map_llrs,
+			&noised_signals,
+			&fading,
+			signals_count,
+			_modulation,
+			PGM_LLR_LOG_MAP,
+			PGST_LLR_HSQUARE,
+			arena);
+
+	unsigned long long violations = 0;
+	for (unsigned long long i = 0; i < llrs_count; i++)
+		if (fabs((double)log_map_llrs[i] - (double)max_log_llrs[i]) > bound + PGST_LLR_PRECISION * fmax(1.0, fabs(log_map_llrs[i])))
+			violations++;
+
+	pga_destroy(arena);
+
+	return (double)violations;
+}
+
+static double pgst_precision_ber(unsigned int _modulation, unsigned int _channel, double _hsquare, unsigned int _precision)
+{
+	pgs_block_t* source_bits;
+	pgs_block_t* source_blocks;
+	pgs_block_t* demodulated_blocks;
+	pgs_block_t* target_blocks;
+	pgs_signals_t modulated_signals;
+	pgs_arena_t* arena = pga_create();
+	unsigned long long source_blocks_count =
+		pgst_prepare_signals(&source_bits,
+				&source_blocks,
+				_precision == PGL_SINGLE ? NULL : &modulated_signals,
+				_modulation,
+				PGST_PRECISION_LENGTH,
+				arena);
+	unsigned long long source_bits_count = source_bits->bits_count;
+
+	unsigned long long demodulated_blocks_count = 0;
+	if (_precision == PGL_SINGLE)
+	{
+		pgs_signals_f_t modulated_signals_f, noised_signals;
+		pgm_modulate_soa_f(&modulated_signals_f, source_blocks, source_blocks_count, _modulation, arena);
+		pgc_add_noise_soa_f(&noised_signals, &modulated_signals_f, source_blocks_count, _channel, _hsquare, pgt_get_context(), arena);
+		demodulated_blocks_count = pgm_demodulate_soa_f(&demodulated_blocks, &noised_signals, source_blocks_count, _modulation, arena);
+	} else
+	{
+		pgs_signals_t noised_signals;
+		pgc_add_noise_soa(&noised_signals, &modulated_signals, source_blocks_count, _channel, _hsquare, pgt_get_context(), arena);
+		demodulated_blocks_count = pgm_demodulate_soa(&demodulated_blocks, &noised_signals, source_blocks_count, _modulation, arena);
+	}
+	if (unlikely(demodulated_blocks_count == 0))
+		pgp_nodata();
+
+	unsigned long long target_blocks_count =
+		pgt_blocks_to_blocks(&target_blocks,
+				demodulated_blocks,
+				demodulated_blocks_count,
+				source_bits_count,
+				arena);
+	if (unlikely(target_blocks_count == 0))
+		pgp_nodata();
+
+	double ber = pgt_get_ber(source_bits,
+			target_blocks,
+			source_bits_count);
+
+	pga_destroy(arena);
 
 	return ber;
 }
 
+static void pgst_precision_test(const char* _subtest_name, unsigned int _modulation, unsigned int _channel, double _hsquare)
+{
+	PGST_START_TEST();
+
+	double ber_double = pgst_precision_ber(_modulation, _channel, pgt_dbs_to_times(_hsquare), PGL_DOUBLE);
+	double ber_single = pgst_precision_ber(_modulation, _channel, pgt_dbs_to_times(_hsquare), PGL_SINGLE);
+	double deviation = 5.0 * sqrt(2.0 * ber_double * (1.0 - ber_double) *
+			(double)pgm_get_block_size(_modulation) / (double)PGST_PRECISION_LENGTH);
+
+	pgst_show_result_lf("Precision", _subtest_name, "single-precision BER", ber_single, ber_double, deviation);
+}
+
 void pgst_run_tests()
 {
 	printf("Performing RNG normalization test…\n");
-	pgst_show_result_lf("RNG", "uniform distribution", "average", pgst_rng_test(PGR_UNIFORM), 0.5, 0.05);
-	pgst_show_result_lf("RNG", "Gaussian distribution", "average", pgst_rng_test(PGR_GAUSSIAN), 0.0, 0.05);
+	pgst_show_result_lf("RNG", "uniform distribution", "average", pgst_rng_test(PGR_UNIFORM, 1), 0.5, 0.05);
+	pgst_show_result_lf("RNG", "Gaussian distribution", "average", pgst_rng_test(PGR_GAUSSIAN, 1), 0.0, 0.05);
+	pgst_show_result_lf("RNG", "Gaussian distribution", "variance", pgst_rng_test(PGR_GAUSSIAN, 2), 1.0, 0.05);
+	pgst_show_result_lf("RNG", "Gaussian distribution", "mass beyond 3σ", pgst_gauss_tail_test(3.0), 0.0026998, 0.0003);
+	pgst_show_result_lf("RNG", "Gaussian distribution", "mass beyond Ziggurat base", pgst_gauss_tail_test(PGR_ZIGGURAT_R), 0.0002580, 0.0001);
+	pgst_show_result_lf("RNG", "bulk uniform distribution", "average", pgst_bulk_rng_test(PGR_UNIFORM, 1), 0.5, 0.05);
+	pgst_show_result_lf("RNG", "bulk Gaussian distribution", "average", pgst_bulk_rng_test(PGR_GAUSSIAN, 1), 0.0, 0.05);
+	pgst_show_result_lf("RNG", "bulk Gaussian distribution", "variance", pgst_bulk_rng_test(PGR_GAUSSIAN, 2), 1.0, 0.05);
+	pgst_show_result_lf("RNG", "bulk single-precision Gaussian distribution", "mismatches against double precision", pgst_bulk_gauss_f_test(), 0.0, 0.0);
+	pgst_show_result_lf("RNG", "bulk single-precision Gaussian distribution", "mass beyond 4.5σ relative to exact", pgst_bulk_gauss_f_tail_test(4.5), 1.0, 0.25);
+	pgst_show_result_lf("RNG", "bulk single-precision Gaussian distribution", "mass beyond Ziggurat base relative to exact", pgst_bulk_gauss_f_tail_test(PGR_ZIGGURAT_R), 1.0, 0.05);
+	pgst_show_result_lf("RNG", "Philox4x32-10", "wrong known-answer words", pgst_philox_test(), 0.0, 0.0);
+
+	printf("Performing error counters test…\n");
+	pgst_show_result_lf("Error counter", pge_to_string(PGE_BER), "wrong bits", pgst_error_counter_test(PGE_BER), 154.0, 0.0);
+	pgst_show_result_lf("Error counter", pge_to_string(PGE_SER), "wrong bytes", pgst_error_counter_test(PGE_SER), 87.0, 0.0);
 
 	printf("Performing codecs test…\n");
 	pgst_show_result_lf("FEC", pgf_to_string(PGF_NONE), "BER", pgst_fec_test(PGF_NONE), 0.0, 0.0);
@@ -231,6 +951,20 @@ void pgst_run_tests()
 	pgst_show_result_lf("FEC", pgf_to_string(PGF_CYCLIC85), "BER", pgst_fec_test(PGF_CYCLIC85), 0.0, 0.0);
 	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH1557), "BER", pgst_fec_test(PGF_BCH1557), 0.0, 0.0);
 	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH1575), "BER", pgst_fec_test(PGF_BCH1575), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH63457), "BER", pgst_fec_test(PGF_BCH63457), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH2552239), "BER", pgst_fec_test(PGF_BCH2552239), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH102392321), "BER", pgst_fec_test(PGF_BCH102392321), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_HAMMING74), "wrong bits after t errors", pgst_correction_test(PGF_HAMMING74, PGF_HAMMING74_FEC_POWER, 0), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_CYCLIC85), "wrong bits after t errors", pgst_correction_test(PGF_CYCLIC85, PGF_CYCLIC85_FEC_POWER, 1), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH1557), "wrong bits after t errors", pgst_correction_test(PGF_BCH1557, PGF_BCH1557_FEC_POWER, 0), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH1575), "wrong bits after t errors", pgst_correction_test(PGF_BCH1575, PGF_BCH1575_FEC_POWER, 0), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_HAMMING74), "sliced/per-codeword mismatches", pgst_slice_test(PGF_HAMMING74), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_CYCLIC85), "sliced/per-codeword mismatches", pgst_slice_test(PGF_CYCLIC85), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH1557), "sliced/per-codeword mismatches", pgst_slice_test(PGF_BCH1557), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH1575), "sliced/per-codeword mismatches", pgst_slice_test(PGF_BCH1575), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH63457), "wrong bits after t errors", pgst_correction_test(PGF_BCH63457, PGF_BCH63457_FEC_POWER, 0), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH2552239), "wrong bits after t errors", pgst_correction_test(PGF_BCH2552239, PGF_BCH2552239_FEC_POWER, 0), 0.0, 0.0);
+	pgst_show_result_lf("FEC", pgf_to_string(PGF_BCH102392321), "wrong bits after t errors", pgst_correction_test(PGF_BCH102392321, PGF_BCH102392321_FEC_POWER, 0), 0.0, 0.0);
 
 	printf("Performing modulators test…\n");
 	pgst_show_result_lf("Modulator", pgm_to_string(PGM_ASK), "BER", pgst_modulator_test(PGM_ASK), 0.0, 0.0);
@@ -251,6 +985,42 @@ void pgst_run_tests()
 	pgst_show_result_lf("Modulator", pgm_to_string(PGM_1024QAM), "BER", pgst_modulator_test(PGM_1024QAM), 0.0, 0.0);
 	pgst_show_result_lf("Modulator", pgm_to_string(PGM_4096QAM), "BER", pgst_modulator_test(PGM_4096QAM), 0.0, 0.0);
 
+	printf("Performing demodulators test…\n");
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_8PSK), "non-nearest decisions", pgst_demodulator_test(PGM_8PSK, pgm_8psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_16PSK), "non-nearest decisions", pgst_demodulator_test(PGM_16PSK, pgm_16psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_32PSK), "non-nearest decisions", pgst_demodulator_test(PGM_32PSK, pgm_32psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_64PSK), "non-nearest decisions", pgst_demodulator_test(PGM_64PSK, pgm_64psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_256PSK), "non-nearest decisions", pgst_demodulator_test(PGM_256PSK, pgm_256psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_1024PSK), "non-nearest decisions", pgst_demodulator_test(PGM_1024PSK, pgm_1024psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_4096PSK), "non-nearest decisions", pgst_demodulator_test(PGM_4096PSK, pgm_4096psk_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_16QAM), "non-nearest decisions", pgst_demodulator_test(PGM_16QAM, pgm_16qam_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_32QAM), "non-nearest decisions", pgst_demodulator_test(PGM_32QAM, pgm_32qam_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_64QAM), "non-nearest decisions", pgst_demodulator_test(PGM_64QAM, pgm_64qam_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_256QAM), "non-nearest decisions", pgst_demodulator_test(PGM_256QAM, pgm_256qam_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_1024QAM), "non-nearest decisions", pgst_demodulator_test(PGM_1024QAM, pgm_1024qam_table), 0.0, 0.0);
+	pgst_show_result_lf("Demodulator", pgm_to_string(PGM_4096QAM), "non-nearest decisions", pgst_demodulator_test(PGM_4096QAM, pgm_4096qam_table), 0.0, 0.0);
+
+	printf("Performing soft demodulators test…\n");
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_QPSK), "max-log BER", pgst_llr_test(PGM_QPSK, PGM_LLR_MAX_LOG), 0.0, 0.0);
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_8PSK), "log-MAP BER", pgst_llr_test(PGM_8PSK, PGM_LLR_LOG_MAP), 0.0, 0.0);
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_16QAM), "max-log BER", pgst_llr_test(PGM_16QAM, PGM_LLR_MAX_LOG), 0.0, 0.0);
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_32QAM), "log-MAP BER", pgst_llr_test(PGM_32QAM, PGM_LLR_LOG_MAP), 0.0, 0.0);
+
+	pgst_show_result_lf("Soft demodulator", pgc_channel_to_string(PGC_AWGN), "BPSK LLR deviation", pgst_llr_value_test(PGC_AWGN), 0.0, PGST_LLR_PRECISION);
+	pgst_show_result_lf("Soft demodulator", pgc_channel_to_string(PGC_RAYLEIGH), "BPSK LLR deviation", pgst_llr_value_test(PGC_RAYLEIGH), 0.0, PGST_LLR_PRECISION);
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_8PSK), "log-MAP LLR deviation", pgst_llr_log_map_test(PGM_8PSK, pgm_8psk_table), 0.0, PGST_LLR_PRECISION);
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_16QAM), "log-MAP LLR deviation", pgst_llr_log_map_test(PGM_16QAM, pgm_16qam_table), 0.0, PGST_LLR_PRECISION);
+	pgst_show_result_lf("Soft demodulator", pgm_to_string(PGM_16QAM), "max-log LLRs beyond log(M/2)", pgst_llr_max_log_test(PGM_16QAM), 0.0, 0.0);
+
+	printf("Performing channel test…\n");
+	pgst_show_result_lf("Channel", pgc_channel_to_string(PGC_AWGN), "AoS/SoA deviation", pgst_channel_test(PGC_AWGN), 0.0, PGST_CHANNEL_PRECISION);
+	pgst_show_result_lf("Channel", pgc_channel_to_string(PGC_RAYLEIGH), "AoS/SoA deviation", pgst_channel_test(PGC_RAYLEIGH), 0.0, PGST_CHANNEL_PRECISION);
+
+	printf("Performing signal precision test…\n");
+	pgst_precision_test("QPSK, AWGN, 4 dB", PGM_QPSK, PGC_AWGN, 4.0);
+	pgst_precision_test("16-QAM, AWGN, 10 dB", PGM_16QAM, PGC_AWGN, 10.0);
+	pgst_precision_test("8-PSK, Rayleigh, 12 dB", PGM_8PSK, PGC_RAYLEIGH, 12.0);
+
 	printf("Tests: %llu, passed: %llu, failed: %llu\n", all_tests_count, passed_tests_count, failed_tests_count);
 }
 
@@ -27,7 +27,23 @@
 #define PGST_START_TEST()	all_tests_count++
 
 #define PGST_RNG_ITERATIONS	1000000
+#define PGST_TAIL_ROUNDS	64
 #define PGST_SOURCE_LENGTH	30
+#define PGST_PRECISION_LENGTH	1048576
+#define PGST_CHANNEL_LENGTH	4098
+#define PGST_CHANNEL_PRECISION	1e-9
+#define PGST_DEMODULATOR_POINTS	8192
+#define PGST_DEMODULATOR_SIGMA	0.5
+#define PGST_DEMODULATOR_NEIGHBOURS	8
+#define PGST_DEMODULATOR_REACH	1.5
+#define PGST_DEMODULATOR_OFFSET	1e-6
+#define PGST_DEMODULATOR_PRECISION	1e-9
+#define PGST_LLR_HSQUARE	2.0
+#define PGST_LLR_PRECISION	1e-5
+#define PGST_COUNTER_LENGTH	1000
+#define PGST_COUNTER_STRIDE	13
+#define PGST_BCH_CODEWORDS	64
+#define PGST_SLICE_CODEWORDS	1234
 
 void pgst_run_tests();
 
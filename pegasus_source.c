@@ -56,60 +56,43 @@ char* pgs_source_to_string(unsigned int _source)
 static void pgs_generate_random(pgs_block_t* _data_buffer,
 		unsigned long long _amount)
 {
-	unsigned long long extra_bits = _amount % PGS_UINT64_SIZE;
-	unsigned long long bits_count = _amount - extra_bits;
-#if defined(_OPENMP)
-#pragma omp parallel for
-#endif
-	for (unsigned long long i = 0; i < bits_count; i += PGS_UINT64_SIZE)
-	{
-		pgs_block_t* current_block = pgb_create_block(PGS_UINT64_SIZE);
-		unsigned long long current_ull = pgr_get_u64();
-		pgb_ull_to_block(current_block, current_ull);
-		pgb_copy(&_data_buffer[0], i, current_block, 0, PGS_UINT64_SIZE);
-		pgb_destroy_block(current_block);
-	}
+	unsigned long long extra_bits = PGB_OFFSET(_amount);
+	unsigned long long words_count = _amount / PGS_UINT64_SIZE;
+	pgr_fill_u64(_data_buffer->chunk, extra_bits > 0 ? words_count + 1 : words_count);
 	if (extra_bits > 0)
-	{
-		pgs_block_t* current_block = pgb_create_block(PGS_UINT64_SIZE);
-		unsigned long long current_ull = pgr_get_u64();
-		pgb_ull_to_block(current_block, current_ull);
-		pgb_copy(&_data_buffer[0], bits_count, current_block, 0, extra_bits);
-		pgb_destroy_block(current_block);
-	}
+		_data_buffer->chunk[words_count] &= PGB_HEAD_MASK(extra_bits);
 }
 
 static void pgs_generate_predefined(pgs_block_t* _data_buffer,
 		unsigned int _modulation,
-		unsigned long long _amount)
+		unsigned long long _amount,
+		unsigned long long _offset)
 {
 	unsigned long long modulation_block_size = pgm_get_block_size(_modulation);
+	unsigned long long modulation_volume = pgm_get_volume(_modulation);
 	unsigned long long extra_bits = _amount % modulation_block_size;
-	unsigned long long current_index = 0;
-	pgs_block_t* current_block = pgb_create_block(modulation_block_size);
+	unsigned long long current_index = (_offset / modulation_block_size) % modulation_volume;
 	for (unsigned long long i = 0; i < _amount - extra_bits; i += modulation_block_size)
 	{
-		pgb_ull_to_block(current_block, current_index);
-		pgb_copy(&_data_buffer[0], i, current_block, 0, modulation_block_size);
+		pgb_set_bits(_data_buffer, i, modulation_block_size, current_index);
 
 		current_index++;
-		if (unlikely(current_index >= pgm_get_volume(_modulation)))
+		if (unlikely(current_index >= modulation_volume))
 			current_index = 0;
 	}
 	if (extra_bits > 0)
-	{
-		pgb_ull_to_block(current_block, current_index);
-		pgb_copy(&_data_buffer[0], _amount - extra_bits, current_block, 0, extra_bits);
-	}
-	pgb_destroy_block(current_block);
+		pgb_set_bits(_data_buffer, _amount - extra_bits, extra_bits,
+				current_index >> (modulation_block_size - extra_bits));
 }
 
 unsigned long long pgs_generate(pgs_block_t** _data_buffer,
 		unsigned int _source,
 		unsigned int _modulation,
-		unsigned long long _amount)
+		unsigned long long _amount,
+		unsigned long long _offset,
+		pgs_arena_t* _arena)
 {
-	*_data_buffer = pgb_create_block(_amount);
+	*_data_buffer = pgb_alloc_blocks(_arena, 1, _amount);
 
 	switch (_source)
 	{
@@ -117,7 +100,7 @@ unsigned long long pgs_generate(pgs_block_t** _data_buffer,
 			pgs_generate_random(*_data_buffer, _amount);
 			break;
 		case PGS_PREDEFINED:
-			pgs_generate_predefined(*_data_buffer, _modulation, _amount);
+			pgs_generate_predefined(*_data_buffer, _modulation, _amount, _offset);
 			break;
 		default:
 			break;
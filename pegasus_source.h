@@ -36,7 +36,9 @@ char* pgs_source_to_string(unsigned int _source);
 unsigned long long pgs_generate(pgs_block_t** _data_buffer,
 		unsigned int _source,
 		unsigned int _modulation,
-		unsigned long long _amount);
+		unsigned long long _amount,
+		unsigned long long _offset,
+		pgs_arena_t* _arena);
 
 #endif /* PEGASUS_SOURCE_H */
 
@@ -24,9 +24,11 @@
 #include <omp.h>
 #endif
 #include <stdlib.h>
+#include <string.h>
 
 #include "pegasus_common_types.h"
 
+#include "pegasus_arena.h"
 #include "pegasus_block.h"
 #include "pegasus_panic.h"
 
@@ -39,6 +41,29 @@ void pgt_init_threads()
 #else
 	pgt_threads = 1;
 #endif
+
+	pgt_contexts = pgt_alloc_aligned(pgt_threads, sizeof(pgs_context_t));
+}
+
+void pgt_done_threads()
+{
+	for (unsigned long long i = 0; i < pgt_threads; i++)
+		pga_done(&pgt_contexts[i].arena);
+	free(pgt_contexts);
+}
+
+inline unsigned long long pgt_thread_num()
+{
+#if defined(_OPENMP)
+	return omp_get_level() > 0 ? omp_get_ancestor_thread_num(1) : 0;
+#else
+	return 0;
+#endif
+}
+
+pgs_context_t* pgt_get_context()
+{
+	return &pgt_contexts[pgt_thread_num()];
 }
 
 void* pgt_alloc(size_t _items, size_t _item_size)
@@ -50,10 +75,23 @@ void* pgt_alloc(size_t _items, size_t _item_size)
 	return pointer;
 }
 
+void* pgt_alloc_aligned(size_t _items, size_t _item_size)
+{
+	void* pointer = NULL;
+	size_t size = (_items * _item_size + PGS_CACHE_LINE - 1) / PGS_CACHE_LINE * PGS_CACHE_LINE;
+
+	if (unlikely(posix_memalign(&pointer, PGS_CACHE_LINE, size) != 0))
+		pgp_malloc();
+	memset(pointer, 0, size);
+
+	return pointer;
+}
+
 unsigned long long pgt_blocks_to_blocks(pgs_block_t** _target_blocks,
 		pgs_block_t* _source_blocks,
 		unsigned long long _source_blocks_count,
-		unsigned long long _target_block_size)
+		unsigned long long _target_block_size,
+		pgs_arena_t* _arena)
 {
 	if (unlikely(_source_blocks == NULL))
 		return 0;
@@ -67,20 +105,30 @@ unsigned long long pgt_blocks_to_blocks(pgs_block_t** _target_blocks,
 	if ((_source_blocks_count * source_block_size) % _target_block_size != 0)
 		target_blocks_count++;
 
-	*_target_blocks = pgb_create_blocks(target_blocks_count, _target_block_size);
+	*_target_blocks = pgb_alloc_blocks(_arena, target_blocks_count, _target_block_size);
+
+	unsigned long long total_bits = _source_blocks_count * source_block_size;
 
 #if defined(_OPENMP)
 #pragma omp parallel for
 #endif
-	for (unsigned long long i = 0; i < _source_blocks_count; i++)
+	for (unsigned long long i = 0; i < target_blocks_count; i++)
 	{
-		unsigned long long source_bits_passed = i * source_block_size;
-		for (unsigned long long j = 0; j < source_block_size; j++)
+		unsigned long long target_bits_passed = i * _target_block_size;
+		unsigned long long target_bits_end = target_bits_passed + _target_block_size;
+		if (target_bits_end > total_bits)
+			target_bits_end = total_bits;
+		for (unsigned long long j = target_bits_passed; j < target_bits_end;)
 		{
-			unsigned long long source_bit_serial_index = source_bits_passed + j;
-			unsigned long long target_block_index = source_bit_serial_index / _target_block_size;
-			unsigned long long target_bit_index = source_bit_serial_index % _target_block_size;
-			pgb_copy_bit(&((pgs_block_t*)(*_target_blocks))[target_block_index], target_bit_index, &_source_blocks[i], j);
+			unsigned long long source_block_index = j / source_block_size;
+			unsigned long long source_bit_index = j % source_block_size;
+			unsigned long long amount = source_block_size - source_bit_index;
+			if (amount > target_bits_end - j)
+				amount = target_bits_end - j;
+			pgb_copy(&((pgs_block_t*)(*_target_blocks))[i], j - target_bits_passed,
+					&_source_blocks[source_block_index], source_bit_index,
+					amount);
+			j += amount;
 		}
 	}
 
@@ -92,29 +140,30 @@ unsigned long long pgt_value_to_gray(unsigned long long _value)
 	return (_value >> 1ULL) ^ _value;
 }
 
-double pgt_get_ber(pgs_block_t* _original,
+unsigned long long pgt_count_wrong_bits(pgs_block_t* _original,
 		pgs_block_t* _distorted,
 		unsigned long long _length)
 {
 	if (unlikely(_original == NULL || _distorted == NULL))
 		return 0;
 
+	const uint64_t* restrict original = _original->chunk;
+	const uint64_t* restrict distorted = _distorted->chunk;
+	unsigned long long words = PGB_WORD(_length);
 	unsigned long long wrong_bits = 0;
 
 #if defined(_OPENMP)
-#pragma omp parallel for
+#pragma omp parallel for reduction(+:wrong_bits)
 #endif
-	for (unsigned long long i = 0; i < _length; i++)
-		if (!pgb_cmp_bit(&_original[0], i, &_distorted[0], i))
-#if defined(_OPENMP)
-#pragma omp atomic
-#endif
-			wrong_bits++;
+	for (unsigned long long i = 0; i < words; i++)
+		wrong_bits += pgt_popcount(original[i] ^ distorted[i]);
+	if (PGB_OFFSET(_length) > 0)
+		wrong_bits += pgt_popcount((original[words] ^ distorted[words]) & PGB_HEAD_MASK(PGB_OFFSET(_length)));
 
-	return (double)wrong_bits / (double)_length;
+	return wrong_bits;
 }
 
-double pgt_get_ser(pgs_block_t* _original,
+unsigned long long pgt_count_wrong_blocks(pgs_block_t* _original,
 		pgs_block_t* _distorted,
 		unsigned long long _blocks_count)
 {
@@ -124,22 +173,38 @@ double pgt_get_ser(pgs_block_t* _original,
 	unsigned long long wrong_blocks = 0;
 
 #if defined(_OPENMP)
-#pragma omp parallel for
+#pragma omp parallel for reduction(+:wrong_blocks)
 #endif
 	for (unsigned long long i = 0; i < _blocks_count; i++)
 	{
-		unsigned long long wrong_bits = 0;
-		for (unsigned long long j = 0; j < _original[i].bits_count; j++)
-			if (!pgb_cmp_bit(&_original[i], j, &_distorted[i], j))
-				wrong_bits++;
-		if (wrong_bits > 0)
-#if defined(_OPENMP)
-#pragma omp atomic
-#endif
-			wrong_blocks++;
+		const uint64_t* original = _original[i].chunk;
+		const uint64_t* distorted = _distorted[i].chunk;
+		unsigned long long words = PGB_WORD(_original[i].bits_count);
+		unsigned long long offset = PGB_OFFSET(_original[i].bits_count);
+		uint64_t difference = 0;
+
+		for (unsigned long long j = 0; j < words; j++)
+			difference |= original[j] ^ distorted[j];
+		if (offset > 0)
+			difference |= (original[words] ^ distorted[words]) & PGB_HEAD_MASK(offset);
+		wrong_blocks += difference != 0;
 	}
 
-	return (double)wrong_blocks / (double)_blocks_count;
+	return wrong_blocks;
+}
+
+double pgt_get_ber(pgs_block_t* _original,
+		pgs_block_t* _distorted,
+		unsigned long long _length)
+{
+	return (double)pgt_count_wrong_bits(_original, _distorted, _length) / (double)_length;
+}
+
+double pgt_get_ser(pgs_block_t* _original,
+		pgs_block_t* _distorted,
+		unsigned long long _blocks_count)
+{
+	return (double)pgt_count_wrong_blocks(_original, _distorted, _blocks_count) / (double)_blocks_count;
 }
 
 double pgt_dbs_to_times(double _dbs)
@@ -147,10 +212,10 @@ double pgt_dbs_to_times(double _dbs)
 	return pow(10.0, _dbs / 10.0);
 }
 
-unsigned long long pgt_popcount(unsigned long long _value)
+inline unsigned long long pgt_popcount(unsigned long long _value)
 {
 #ifdef __GNUC__
-	return __builtin_popcount(_value);
+	return __builtin_popcountll(_value);
 #else /* __GNUC__ */
 	unsigned long long ret = 0;
 	for (unsigned long long i = 0; i < sizeof(unsigned long long) * CHAR_BIT; i++)
@@ -27,14 +27,26 @@
 #include "pegasus_common_types.h"
 
 unsigned long long pgt_threads;
+pgs_context_t* pgt_contexts;
 
 void pgt_init_threads();
+void pgt_done_threads();
+unsigned long long pgt_thread_num();
+pgs_context_t* pgt_get_context();
 void* pgt_alloc(size_t _items, size_t _item_size);
+void* pgt_alloc_aligned(size_t _items, size_t _item_size);
 unsigned long long pgt_blocks_to_blocks(pgs_block_t** _target_blocks,
 		pgs_block_t* _source_blocks,
 		unsigned long long _source_blocks_count,
-		unsigned long long _target_block_size);
+		unsigned long long _target_block_size,
+		pgs_arena_t* _arena);
 unsigned long long pgt_value_to_gray(unsigned long long _value);
+unsigned long long pgt_count_wrong_bits(pgs_block_t* _original,
+		pgs_block_t* _distorted,
+		unsigned long long _length);
+unsigned long long pgt_count_wrong_blocks(pgs_block_t* _original,
+		pgs_block_t* _distorted,
+		unsigned long long _blocks_count);
 double pgt_get_ber(pgs_block_t* _original,
 		pgs_block_t* _distorted,
 		unsigned long long _length);